@@ -13,6 +13,7 @@
 #include "schwarzschild.hpp"
 #include <cmath>
 #include <array>
+#include <vector>
 
 namespace BuracoNegro {
 
@@ -62,7 +63,175 @@ private:
     
     // Constante de Stefan-Boltzmann para cálculo de temperatura
     static constexpr double SIGMA_SB = 5.670374419e-8;
-    
+
+    double T_estrela_;          // Temperatura característica no ISCO
+
+    // Tabela radial pré-computada: temperatura, cor base de corpo
+    // negro e fator de redshift só dependem de r, então são avaliados
+    // uma vez na construção e servidos por interpolação linear. Os
+    // logs e pows das funções exatas saem do caminho quente por raio.
+    struct EntradaTabela {
+        double temperatura;
+        CorRGB cor_base;
+        double redshift;
+        double beta;    // v_kepleriana / c
+        double gamma;   // Fator de Lorentz correspondente
+    };
+    static constexpr int NUM_ENTRADAS_TABELA = 2048;
+    std::vector<EntradaTabela> tabela_;
+
+    void construir_tabela() {
+        tabela_.resize(NUM_ENTRADAS_TABELA);
+        for (int k = 0; k < NUM_ENTRADAS_TABELA; k++) {
+            double raio = raio_interno_ + (raio_externo_ - raio_interno_) *
+                          k / (NUM_ENTRADAS_TABELA - 1);
+            EntradaTabela& e = tabela_[k];
+            e.temperatura = temperatura(raio);
+            e.cor_base = cor_corpo_negro(e.temperatura);
+            e.redshift = fator_redshift(raio);
+            e.beta = velocidade_kepleriana(raio) / C;
+            e.gamma = 1.0 / std::sqrt(1.0 - e.beta * e.beta);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Modo espectral: tabela 2D (temperatura × shift) → RGB
+    // ------------------------------------------------------------
+
+    bool espectral_ = false;
+    static constexpr int NT_ESPECTRO = 64;   // Eixo de temperatura
+    static constexpr int NG_ESPECTRO = 64;   // Eixo de shift g = D·√f
+    double log_T_min_ = 0.0, log_T_max_ = 0.0;
+    double log_g_min_ = 0.0, log_g_max_ = 0.0;
+    std::vector<CorRGB> tabela_espectral_;   // NT x NG, row-major em T
+
+    // Gaussiana assimétrica usada nos ajustes analíticos das curvas
+    // de resposta CIE 1931 (Wyman, Sloan & Shirley 2013)
+    static double gauss_cie(double x, double mu, double s1, double s2) {
+        double t = (x - mu) / (x < mu ? s1 : s2);
+        return std::exp(-0.5 * t * t);
+    }
+
+    // Curvas de resposta x̄, ȳ, z̄ (λ em nm)
+    static double cie_x(double l) {
+        return 1.056 * gauss_cie(l, 599.8, 37.9, 31.0) +
+               0.362 * gauss_cie(l, 442.0, 16.0, 26.7) -
+               0.065 * gauss_cie(l, 501.1, 20.4, 26.2);
+    }
+    static double cie_y(double l) {
+        return 0.821 * gauss_cie(l, 568.8, 46.9, 40.5) +
+               0.286 * gauss_cie(l, 530.9, 16.3, 31.1);
+    }
+    static double cie_z(double l) {
+        return 1.217 * gauss_cie(l, 437.0, 11.8, 36.0) +
+               0.681 * gauss_cie(l, 459.0, 26.0, 13.8);
+    }
+
+    // Cor exata de um elemento do disco a temperatura T visto com
+    // shift total g = D·√f: a invariância de I_ν/ν³ dá
+    // B_obs(ν) = g³ B(ν/g, T), que é amostrada no visível e integrada
+    // contra as curvas CIE; XYZ vai para sRGB linear (D65). Só roda na
+    // construção da tabela — o caminho por raio faz uma busca bilinear.
+    CorRGB cor_espectral(double T, double g) const {
+        const int n = 48;
+        const double l0 = 380.0, l1 = 780.0;   // nm
+        double dl = (l1 - l0) / n;
+
+        double X = 0.0, Y = 0.0, Z = 0.0;
+        for (int k = 0; k < n; k++) {
+            double lambda = l0 + (k + 0.5) * dl;
+            double nu_obs = C / (lambda * 1e-9);
+            double B = g * g * g * planck(nu_obs / g, T);
+            X += B * cie_x(lambda);
+            Y += B * cie_y(lambda);
+            Z += B * cie_z(lambda);
+        }
+        X *= dl; Y *= dl; Z *= dl;
+
+        CorRGB cor = {
+             3.2406 * X - 1.5372 * Y - 0.4986 * Z,
+            -0.9689 * X + 1.8758 * Y + 0.0415 * Z,
+             0.0557 * X - 0.2040 * Y + 1.0570 * Z
+        };
+        cor.r = std::max(0.0, cor.r);
+        cor.g = std::max(0.0, cor.g);
+        cor.b = std::max(0.0, cor.b);
+        return cor;
+    }
+
+    void construir_tabela_espectral() {
+        // Cobre das bordas frias do disco ao máximo com folga, e
+        // shifts de forte redshift (borda interna vista por trás) a
+        // forte blueshift (lado que se aproxima)
+        log_T_min_ = std::log(1.0e3);
+        log_T_max_ = std::log(std::max(1.0e4, 10.0 * temperatura_maxima()));
+        log_g_min_ = std::log(0.05);
+        log_g_max_ = std::log(20.0);
+
+        // Normalização: luminância 1 no máximo do disco sem shift,
+        // para a escala de brilho casar com o caminho não espectral
+        double escala = cor_espectral(temperatura_maxima(), 1.0).g;
+        if (escala <= 0.0) escala = 1.0;
+
+        tabela_espectral_.resize(NT_ESPECTRO * NG_ESPECTRO);
+        for (int it = 0; it < NT_ESPECTRO; it++) {
+            double T = std::exp(log_T_min_ + (log_T_max_ - log_T_min_) *
+                                it / (NT_ESPECTRO - 1));
+            for (int ig = 0; ig < NG_ESPECTRO; ig++) {
+                double g = std::exp(log_g_min_ +
+                                    (log_g_max_ - log_g_min_) *
+                                    ig / (NG_ESPECTRO - 1));
+                tabela_espectral_[it * NG_ESPECTRO + ig] =
+                    cor_espectral(T, g) * (1.0 / escala);
+            }
+        }
+    }
+
+    // Busca bilinear na tabela espectral (eixos em log T, log g)
+    CorRGB amostrar_espectro(double T, double g) const {
+        auto indice = [](double v, double v0, double v1, int n,
+                         int& k, double& frac) {
+            double x = (std::log(v) - v0) / (v1 - v0) * (n - 1);
+            x = std::max(0.0, std::min(static_cast<double>(n - 1), x));
+            k = std::min(n - 2, static_cast<int>(x));
+            frac = x - k;
+        };
+
+        int it, ig;
+        double ft, fg;
+        indice(std::max(T, 1.0), log_T_min_, log_T_max_, NT_ESPECTRO,
+               it, ft);
+        indice(std::max(g, 1e-6), log_g_min_, log_g_max_, NG_ESPECTRO,
+               ig, fg);
+
+        const CorRGB& c00 = tabela_espectral_[it * NG_ESPECTRO + ig];
+        const CorRGB& c01 = tabela_espectral_[it * NG_ESPECTRO + ig + 1];
+        const CorRGB& c10 = tabela_espectral_[(it + 1) * NG_ESPECTRO + ig];
+        const CorRGB& c11 = tabela_espectral_[(it + 1) * NG_ESPECTRO + ig + 1];
+
+        return (c00 * (1.0 - fg) + c01 * fg) * (1.0 - ft) +
+               (c10 * (1.0 - fg) + c11 * fg) * ft;
+    }
+
+    // Entrada interpolada para um raio dentro do disco
+    EntradaTabela interpolar(double raio) const {
+        double x = (raio - raio_interno_) / (raio_externo_ - raio_interno_) *
+                   (NUM_ENTRADAS_TABELA - 1);
+        int k0 = static_cast<int>(x);
+        k0 = std::max(0, std::min(NUM_ENTRADAS_TABELA - 2, k0));
+        double frac = std::max(0.0, std::min(1.0, x - k0));
+
+        const EntradaTabela& a = tabela_[k0];
+        const EntradaTabela& b = tabela_[k0 + 1];
+        EntradaTabela e;
+        e.temperatura = a.temperatura * (1.0 - frac) + b.temperatura * frac;
+        e.cor_base = a.cor_base * (1.0 - frac) + b.cor_base * frac;
+        e.redshift = a.redshift * (1.0 - frac) + b.redshift * frac;
+        e.beta = a.beta * (1.0 - frac) + b.beta * frac;
+        e.gamma = a.gamma * (1.0 - frac) + b.gamma * frac;
+        return e;
+    }
+
 public:
     // Construtor
     DiscoAcrecao(double massa_solar = 10.0, 
@@ -91,6 +260,16 @@ public:
         double luminosidade_eddington = 1.26e38 * massa_solar;  // W
         double eficiencia = 0.1;  // ~10% para Schwarzschild
         taxa_acrecao_ = taxa_acrecao_eddington * luminosidade_eddington / (eficiencia * C2);
+
+        // Temperatura característica no ISCO (constante do disco)
+        // T_* = [3GMṀ / (8πσr³)]^(1/4)
+        T_estrela_ = std::pow(
+            3.0 * G * massa_bh_ * taxa_acrecao_ /
+            (8.0 * M_PI * SIGMA_SB * std::pow(raio_interno_, 3)),
+            0.25
+        );
+
+        construir_tabela();
     }
 
     // ============================================================
@@ -104,21 +283,13 @@ public:
         if (raio < raio_interno_ || raio > raio_externo_) {
             return 0.0;
         }
-        
-        // Temperatura característica no ISCO
-        // T_* = [3GMṀ / (8πσr³)]^(1/4)
-        double T_estrela = std::pow(
-            3.0 * G * massa_bh_ * taxa_acrecao_ / 
-            (8.0 * M_PI * SIGMA_SB * std::pow(raio_interno_, 3)),
-            0.25
-        );
-        
-        // Perfil radial
+
+        // Perfil radial (T_estrela_ é constante do disco, pré-computada)
         double x = raio / raio_interno_;
         double fator_radial = std::pow(x, -0.75);
         double fator_borda = std::pow(1.0 - std::sqrt(1.0 / x), 0.25);
-        
-        return T_estrela * fator_radial * fator_borda;
+
+        return T_estrela_ * fator_radial * fator_borda;
     }
 
     // ============================================================
@@ -207,20 +378,40 @@ public:
     
     // Intensidade observada com efeitos relativísticos
     // I_obs = D⁴ × I_emitido (para emissão isotrópica)
-    CorRGB intensidade_observada(double raio, double angulo_obs) const {
-        double T = temperatura(raio);
-        if (T <= 0.0) return {0.0, 0.0, 0.0};
-        
-        CorRGB cor = cor_corpo_negro(T);
-        
-        // Efeitos relativísticos
-        double D = fator_doppler(raio, angulo_obs);
-        double z = fator_redshift(raio);
-        
+    //
+    // cos_xi é o cosseno do ângulo entre a velocidade orbital do gás
+    // (+φ̂) e a direção de propagação física do fóton no ponto de
+    // emissão — quem chama extrai isso do momento do fóton no impacto.
+    // (β, γ) vêm da tabela radial junto com o resto, então o beaming
+    // custa a mesma busca interpolada mais um fma e uma divisão.
+    CorRGB intensidade_observada(double raio, double cos_xi) const {
+        if (!no_disco(raio)) return {0.0, 0.0, 0.0};
+
+        EntradaTabela e = interpolar(raio);
+        if (e.temperatura <= 0.0) return {0.0, 0.0, 0.0};
+
+        double D = 1.0 / (e.gamma * (1.0 - e.beta * cos_xi));
+
+        // Modo espectral: o shift total g desloca o espectro de
+        // Planck de verdade (tabela 2D, uma busca bilinear) em vez de
+        // só escalar o brilho da cor empírica por g⁴
+        if (espectral_) {
+            return amostrar_espectro(e.temperatura, D * e.redshift);
+        }
+
         // Combinação de Doppler e redshift gravitacional
-        double fator_total = std::pow(D * z, 4);
-        
-        return cor * fator_total;
+        double fator_total = std::pow(D * e.redshift, 4);
+
+        return e.cor_base * fator_total;
+    }
+
+    // Liga o modo espectral; a tabela (temperatura × shift) → RGB é
+    // construída na primeira ativação
+    void set_espectral(bool usar) {
+        espectral_ = usar;
+        if (espectral_ && tabela_espectral_.empty()) {
+            construir_tabela_espectral();
+        }
     }
 
     // ============================================================
@@ -257,6 +448,7 @@ public:
     double raio_externo() const { return raio_externo_; }
     double massa_bh() const { return massa_bh_; }
     double taxa_acrecao() const { return taxa_acrecao_; }
+    bool espectral() const { return espectral_; }
     
     // Verifica se ponto está no disco
     bool no_disco(double raio) const {
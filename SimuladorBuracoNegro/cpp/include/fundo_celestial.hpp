@@ -0,0 +1,184 @@
+// ============================================================
+// SimuladorBuracoNegro - Fundo Celestial Pré-Rasterizado
+// Autor: Luiz Tiago Wilcke
+//
+// Textura equiretangular do céu (grid + estrelas) construída
+// uma vez na inicialização e amostrada bilinearmente por raio.
+// Substitui o cálculo procedural por raio escapado (~40 ramos
+// e transcendentais) por uma única busca na textura.
+// ============================================================
+
+#ifndef FUNDO_CELESTIAL_HPP
+#define FUNDO_CELESTIAL_HPP
+
+#include "disco_acrecao.hpp"
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace BuracoNegro {
+
+// ============================================================
+// CLASSE FUNDO CELESTIAL
+// ============================================================
+
+class FundoCelestial {
+private:
+    int largura_ = 0;
+    int altura_ = 0;
+    std::vector<float> texels_;  // RGB intercalado, linha a linha
+
+    CorRGB texel(int i, int j) const {
+        size_t k = 3 * (static_cast<size_t>(j) * largura_ + i);
+        return {texels_[k], texels_[k + 1], texels_[k + 2]};
+    }
+
+public:
+    bool vazia() const { return texels_.empty(); }
+    int largura() const { return largura_; }
+    int altura() const { return altura_; }
+
+    // ============================================================
+    // PADRÃO PROCEDURAL (GRID + ESTRELAS)
+    // ============================================================
+
+    // O mesmo padrão que o ray tracer calculava por raio: linhas de
+    // latitude/longitude a cada 15° e estrelas por hash senoidal.
+    // Continua disponível para avaliação direta (fallback sem textura).
+    static CorRGB cor_procedural(double theta, double phi) {
+        // Normaliza ângulos
+        phi = std::fmod(phi, 2.0 * M_PI);
+        if (phi < 0) phi += 2.0 * M_PI;
+
+        // Grid com linhas a cada 15°
+        double espessura = 0.02;
+        double lat = theta - M_PI / 2.0;  // Latitude: -π/2 a π/2
+        double lon = phi;                  // Longitude: 0 a 2π
+
+        // Linhas de latitude (constante θ)
+        bool linha_lat = false;
+        for (double l = -M_PI / 2.0; l <= M_PI / 2.0; l += M_PI / 12.0) {
+            if (std::abs(lat - l) < espessura) {
+                linha_lat = true;
+                break;
+            }
+        }
+
+        // Linhas de longitude (constante φ)
+        bool linha_lon = false;
+        for (double l = 0.0; l < 2.0 * M_PI; l += M_PI / 12.0) {
+            double diff = std::abs(lon - l);
+            if (diff < espessura || (2.0 * M_PI - diff) < espessura) {
+                linha_lon = true;
+                break;
+            }
+        }
+
+        // Cor das linhas
+        if (linha_lat || linha_lon) {
+            // Gradiente azul-roxo baseado na posição
+            double h = (lon / (2.0 * M_PI));  // Hue 0-1
+            return {0.2 + 0.3 * h, 0.1, 0.4 + 0.2 * (1.0 - h)};
+        }
+
+        // Fundo com estrelas (ruído pseudo-aleatório)
+        double seed = theta * 100.0 + phi * 57.0;
+        double estrela = std::sin(seed * 12345.6789);
+        estrela = (estrela + 1.0) / 2.0;
+        estrela = std::pow(estrela, 100.0);  // Poucas estrelas brilhantes
+
+        return {0.01 + 0.5 * estrela, 0.01 + 0.5 * estrela,
+                0.03 + 0.5 * estrela};
+    }
+
+    // ============================================================
+    // CONSTRUÇÃO
+    // ============================================================
+
+    // Rasteriza o padrão procedural numa textura equiretangular:
+    // i cobre φ em [0, 2π), j cobre θ em [0, π]
+    void construir(int largura = 2048, int altura = 1024) {
+        largura_ = largura;
+        altura_ = altura;
+        texels_.assign(3 * static_cast<size_t>(largura) * altura, 0.0f);
+
+        for (int j = 0; j < altura; j++) {
+            double theta = (j + 0.5) / altura * M_PI;
+            for (int i = 0; i < largura; i++) {
+                double phi = (i + 0.5) / largura * 2.0 * M_PI;
+                CorRGB cor = cor_procedural(theta, phi);
+                size_t k = 3 * (static_cast<size_t>(j) * largura + i);
+                texels_[k]     = static_cast<float>(cor.r);
+                texels_[k + 1] = static_cast<float>(cor.g);
+                texels_[k + 2] = static_cast<float>(cor.b);
+            }
+        }
+    }
+
+    // Carrega um mapa de céu equiretangular fornecido pelo usuário
+    // (PPM binário P6, o mesmo formato que o simulador grava)
+    bool carregar_ppm(const std::string& caminho) {
+        std::ifstream arquivo(caminho, std::ios::binary);
+        if (!arquivo.is_open()) return false;
+
+        std::string magica;
+        int largura, altura, maximo;
+        arquivo >> magica >> largura >> altura >> maximo;
+        if (magica != "P6" || largura <= 0 || altura <= 0 || maximo <= 0) {
+            return false;
+        }
+        arquivo.get();  // Único byte de espaço antes do corpo
+
+        std::vector<uint8_t> bytes(3 * static_cast<size_t>(largura) * altura);
+        arquivo.read(reinterpret_cast<char*>(bytes.data()),
+                     static_cast<std::streamsize>(bytes.size()));
+        if (!arquivo.good()) return false;
+
+        largura_ = largura;
+        altura_ = altura;
+        texels_.resize(bytes.size());
+        float escala = 1.0f / static_cast<float>(maximo);
+        for (size_t k = 0; k < bytes.size(); k++) {
+            texels_[k] = bytes[k] * escala;
+        }
+        return true;
+    }
+
+    // ============================================================
+    // AMOSTRAGEM
+    // ============================================================
+
+    // Busca bilinear: φ com repetição periódica, θ com clamp nos polos
+    CorRGB amostrar(double theta, double phi) const {
+        phi = std::fmod(phi, 2.0 * M_PI);
+        if (phi < 0) phi += 2.0 * M_PI;
+        theta = std::max(0.0, std::min(M_PI, theta));
+
+        double x = phi / (2.0 * M_PI) * largura_ - 0.5;
+        double y = theta / M_PI * altura_ - 0.5;
+
+        int i0 = static_cast<int>(std::floor(x));
+        int j0 = static_cast<int>(std::floor(y));
+        double fx = x - i0;
+        double fy = y - j0;
+
+        int i1 = i0 + 1;
+        i0 = (i0 % largura_ + largura_) % largura_;
+        i1 = (i1 % largura_ + largura_) % largura_;
+        int j1 = std::min(altura_ - 1, std::max(0, j0 + 1));
+        j0 = std::min(altura_ - 1, std::max(0, j0));
+
+        CorRGB c00 = texel(i0, j0), c10 = texel(i1, j0);
+        CorRGB c01 = texel(i0, j1), c11 = texel(i1, j1);
+
+        return c00 * ((1.0 - fx) * (1.0 - fy)) +
+               c10 * (fx * (1.0 - fy)) +
+               c01 * ((1.0 - fx) * fy) +
+               c11 * (fx * fy);
+    }
+};
+
+} // namespace BuracoNegro
+
+#endif // FUNDO_CELESTIAL_HPP
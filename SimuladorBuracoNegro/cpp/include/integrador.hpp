@@ -11,6 +11,7 @@
 #include "schwarzschild.hpp"
 #include <vector>
 #include <functional>
+#include <thread>
 
 namespace BuracoNegro {
 
@@ -28,6 +29,14 @@ struct EstadoGeodesica {
     }
 };
 
+// Estado reduzido para geodésicas presas ao plano equatorial:
+// com θ = π/2 e u_θ = 0, a simetria conserva E e L e o sistema
+// cai de 8 para 3 variáveis (t é reconstruível e fica de fora)
+struct EstadoPlanar {
+    double r, phi, u_r;
+    double E, L;    // Integrais de movimento
+};
+
 // Ponto na trajetória para visualização
 struct PontoTrajetoria {
     double lambda;  // Parâmetro afim
@@ -35,9 +44,81 @@ struct PontoTrajetoria {
     double x, y, z; // Coordenadas cartesianas
 };
 
+// Arena de saída pré-alocada pelo chamador para um enxame de
+// trajetórias: a partícula p grava em pontos[p * max_pontos ...],
+// então a integração de 10^5 partículas não faz nenhuma alocação —
+// nada do push_back por ponto do caminho de trajetória única.
+struct ArenaTrajetorias {
+    int num_particulas = 0;
+    int max_pontos = 0;                   // Capacidade por partícula
+    std::vector<PontoTrajetoria> pontos;  // num_particulas * max_pontos
+    std::vector<int> num_pontos;          // Pontos gravados por partícula
+
+    void redimensionar(int particulas, int pontos_por_particula) {
+        num_particulas = particulas;
+        max_pontos = pontos_por_particula;
+        pontos.resize(static_cast<size_t>(particulas) *
+                      pontos_por_particula);
+        num_pontos.assign(particulas, 0);
+    }
+
+    PontoTrajetoria* trajetoria(int p) {
+        return pontos.data() + static_cast<size_t>(p) * max_pontos;
+    }
+    const PontoTrajetoria* trajetoria(int p) const {
+        return pontos.data() + static_cast<size_t>(p) * max_pontos;
+    }
+};
+
+// RK4 no lugar sobre o estado bruto de 8 componentes: a métrica entra
+// por referência e os estágios vivem na pilha do chamador, então o
+// único trabalho por passo é a própria matemática das derivadas.
+inline void passo_rk4_inplace(const MetricaSchwarzschild& metrica,
+                              double* y, double passo) {
+    double k1[8], k2[8], k3[8], k4[8], tmp[8];
+
+    metrica.derivadas_geodesica(y, k1);
+
+    for (int i = 0; i < 8; i++) tmp[i] = y[i] + 0.5 * passo * k1[i];
+    metrica.derivadas_geodesica(tmp, k2);
+
+    for (int i = 0; i < 8; i++) tmp[i] = y[i] + 0.5 * passo * k2[i];
+    metrica.derivadas_geodesica(tmp, k3);
+
+    for (int i = 0; i < 8; i++) tmp[i] = y[i] + passo * k3[i];
+    metrica.derivadas_geodesica(tmp, k4);
+
+    for (int i = 0; i < 8; i++) {
+        y[i] += passo * (k1[i] + 2*k2[i] + 2*k3[i] + k4[i]) / 6.0;
+    }
+}
+
+// Mesmo passo RK4, sobre o estado da carta de Eddington-Finkelstein
+// entrante (v, r, θ, φ, ...) — usado quando o traçador opta pela
+// carta regular no horizonte
+inline void passo_rk4_ef_inplace(const MetricaSchwarzschild& metrica,
+                                 double* y, double passo) {
+    double k1[8], k2[8], k3[8], k4[8], tmp[8];
+
+    metrica.derivadas_geodesica_ef(y, k1);
+
+    for (int i = 0; i < 8; i++) tmp[i] = y[i] + 0.5 * passo * k1[i];
+    metrica.derivadas_geodesica_ef(tmp, k2);
+
+    for (int i = 0; i < 8; i++) tmp[i] = y[i] + 0.5 * passo * k2[i];
+    metrica.derivadas_geodesica_ef(tmp, k3);
+
+    for (int i = 0; i < 8; i++) tmp[i] = y[i] + passo * k3[i];
+    metrica.derivadas_geodesica_ef(tmp, k4);
+
+    for (int i = 0; i < 8; i++) {
+        y[i] += passo * (k1[i] + 2*k2[i] + 2*k3[i] + k4[i]) / 6.0;
+    }
+}
+
 class IntegradorGeodesico {
 private:
-    MetricaSchwarzschild metrica_;
+    const MetricaSchwarzschild& metrica_;
     double passo_;
     double r_min_;
     
@@ -80,6 +161,134 @@ public:
         return EstadoGeodesica::de_array(novo);
     }
     
+    // ============================================================
+    // CAMINHO RÁPIDO EQUATORIAL
+    // ============================================================
+
+    // Passo RK4 do sistema reduzido. As velocidades angular e
+    // temporal vêm das constantes: u_φ = L/r², u_t = E/(1 - rs/r),
+    // então só (r, φ, u_r) precisam ser integrados.
+    EstadoPlanar passo_rk4_planar(const EstadoPlanar& estado) const {
+        double rs = metrica_.raio_schwarzschild();
+
+        auto derivs = [&](double r, double u_r, double E, double L,
+                          double& dr, double& dphi, double& du_r) {
+            double r_seguro = (r <= rs) ? rs * 1.001 : r;
+            double f = 1.0 - rs / r_seguro;
+            double u_t = E / f;
+            double u_phi = L / (r_seguro * r_seguro);
+
+            dr = u_r;
+            dphi = u_phi;
+            // Γ^r_tt u_t² + Γ^r_rr u_r² + Γ^r_φφ u_φ² (sinθ = 1)
+            du_r = -metrica_.christoffel_r_tt(r_seguro) * u_t * u_t
+                   - metrica_.christoffel_r_rr(r_seguro) * u_r * u_r
+                   + (r_seguro - rs) * u_phi * u_phi;
+        };
+
+        double k1r, k1p, k1u, k2r, k2p, k2u, k3r, k3p, k3u, k4r, k4p, k4u;
+        derivs(estado.r, estado.u_r, estado.E, estado.L, k1r, k1p, k1u);
+        derivs(estado.r + 0.5 * passo_ * k1r, estado.u_r + 0.5 * passo_ * k1u,
+               estado.E, estado.L, k2r, k2p, k2u);
+        derivs(estado.r + 0.5 * passo_ * k2r, estado.u_r + 0.5 * passo_ * k2u,
+               estado.E, estado.L, k3r, k3p, k3u);
+        derivs(estado.r + passo_ * k3r, estado.u_r + passo_ * k3u,
+               estado.E, estado.L, k4r, k4p, k4u);
+
+        EstadoPlanar novo = estado;
+        novo.r   += passo_ * (k1r + 2*k2r + 2*k3r + k4r) / 6.0;
+        novo.phi += passo_ * (k1p + 2*k2p + 2*k3p + k4p) / 6.0;
+        novo.u_r += passo_ * (k1u + 2*k2u + 2*k3u + k4u) / 6.0;
+        return novo;
+    }
+
+    // ============================================================
+    // RK45 (DORMAND-PRINCE) COM CONTROLE DE ERRO
+    // ============================================================
+
+    // Passo embutido de 5ª ordem com estimativa de erro de 4ª ordem.
+    // O erro retornado é relativo (normalizado pela escala de cada
+    // componente), para servir de critério de adaptação do passo.
+    EstadoGeodesica passo_rk45(const EstadoGeodesica& estado, double& erro) const {
+        // Tableau de Dormand-Prince
+        static constexpr double a21 = 1.0/5.0;
+        static constexpr double a31 = 3.0/40.0,       a32 = 9.0/40.0;
+        static constexpr double a41 = 44.0/45.0,      a42 = -56.0/15.0,      a43 = 32.0/9.0;
+        static constexpr double a51 = 19372.0/6561.0, a52 = -25360.0/2187.0, a53 = 64448.0/6561.0,  a54 = -212.0/729.0;
+        static constexpr double a61 = 9017.0/3168.0,  a62 = -355.0/33.0,     a63 = 46732.0/5247.0,  a64 = 49.0/176.0,    a65 = -5103.0/18656.0;
+        static constexpr double b1  = 35.0/384.0,     b3  = 500.0/1113.0,    b4  = 125.0/192.0,     b5  = -2187.0/6784.0, b6 = 11.0/84.0;
+        // Pesos do estimador de 4ª ordem
+        static constexpr double e1 = 5179.0/57600.0,  e3 = 7571.0/16695.0,   e4 = 393.0/640.0,
+                                e5 = -92097.0/339200.0, e6 = 187.0/2100.0,   e7 = 1.0/40.0;
+
+        auto arr = estado.como_array();
+        auto derivs = [this](const std::array<double, 8>& y) {
+            Coordenadas pos{y[0], y[1], y[2], y[3]};
+            Quadrivelocidade vel{y[4], y[5], y[6], y[7]};
+            return metrica_.derivadas_geodesica(pos, vel);
+        };
+        double h = passo_;
+
+        auto k1 = derivs(arr);
+
+        std::array<double, 8> y;
+        for (int i = 0; i < 8; i++) y[i] = arr[i] + h * a21 * k1[i];
+        auto k2 = derivs(y);
+
+        for (int i = 0; i < 8; i++) y[i] = arr[i] + h * (a31*k1[i] + a32*k2[i]);
+        auto k3 = derivs(y);
+
+        for (int i = 0; i < 8; i++) y[i] = arr[i] + h * (a41*k1[i] + a42*k2[i] + a43*k3[i]);
+        auto k4 = derivs(y);
+
+        for (int i = 0; i < 8; i++) y[i] = arr[i] + h * (a51*k1[i] + a52*k2[i] + a53*k3[i] + a54*k4[i]);
+        auto k5 = derivs(y);
+
+        for (int i = 0; i < 8; i++) y[i] = arr[i] + h * (a61*k1[i] + a62*k2[i] + a63*k3[i] + a64*k4[i] + a65*k5[i]);
+        auto k6 = derivs(y);
+
+        // Solução de 5ª ordem (também é o estágio k7: propriedade FSAL)
+        std::array<double, 8> novo;
+        for (int i = 0; i < 8; i++) {
+            novo[i] = arr[i] + h * (b1*k1[i] + b3*k3[i] + b4*k4[i] + b5*k5[i] + b6*k6[i]);
+        }
+        auto k7 = derivs(novo);
+
+        // Erro = diferença entre as soluções de 5ª e 4ª ordem
+        erro = 0.0;
+        for (int i = 0; i < 8; i++) {
+            double y4 = arr[i] + h * (e1*k1[i] + e3*k3[i] + e4*k4[i] +
+                                      e5*k5[i] + e6*k6[i] + e7*k7[i]);
+            double escala = std::abs(arr[i]) + std::abs(h * k1[i]) + 1e-30;
+            erro = std::max(erro, std::abs(novo[i] - y4) / escala);
+        }
+
+        return EstadoGeodesica::de_array(novo);
+    }
+
+    // Passo adaptativo: aceita o passo se o erro relativo fica abaixo
+    // da tolerância, senão reduz e tenta de novo; em ambos os casos
+    // propõe o tamanho do próximo passo. No campo distante, onde a
+    // métrica é quase plana, o passo cresce ordens de grandeza.
+    EstadoGeodesica passo_adaptativo(const EstadoGeodesica& estado,
+                                     double tolerancia = 1e-6) {
+        for (int tentativa = 0; tentativa < 10; tentativa++) {
+            double erro;
+            EstadoGeodesica novo = passo_rk45(estado, erro);
+
+            double fator = 0.9 * std::pow(tolerancia / std::max(erro, 1e-300), 0.2);
+            fator = std::max(0.2, std::min(5.0, fator));
+
+            if (erro <= tolerancia) {
+                passo_ *= fator;
+                return novo;
+            }
+            passo_ *= fator;
+        }
+        // Não convergiu: avança com RK4 fixo para não travar o raio
+        return passo_rk4(estado);
+    }
+
     // Integrar trajetória completa
     std::vector<PontoTrajetoria> integrar(
         const EstadoGeodesica& inicial,
@@ -109,6 +318,67 @@ public:
         return trajetoria;
     }
     
+    // Integra um enxame de partículas em paralelo, gravando um ponto a
+    // cada `estride` passos direto na arena do chamador (sem nenhuma
+    // alocação no laço). Cada partícula para no horizonte, ao encher o
+    // seu segmento da arena ou em lambda_max, como em integrar().
+    void integrar_lote(const std::vector<EstadoGeodesica>& iniciais,
+                       double lambda_max,
+                       ArenaTrajetorias& arena,
+                       int estride = 1,
+                       int num_threads = 1) const {
+        int n = static_cast<int>(iniciais.size());
+        estride = std::max(1, estride);
+        if (arena.num_particulas != n || arena.max_pontos <= 0) {
+            arena.redimensionar(
+                n, arena.max_pontos > 0 ? arena.max_pontos : 1024);
+        }
+
+        auto trabalhador = [&](int p0, int p1) {
+            for (int p = p0; p < p1; p++) {
+                std::array<double, 8> y = iniciais[p].como_array();
+                PontoTrajetoria* saida = arena.trajetoria(p);
+                int gravados = 0;
+                long num_passo = 0;
+                double lambda = 0.0;
+
+                while (lambda < lambda_max &&
+                       gravados < arena.max_pontos) {
+                    if (y[1] < r_min_) break;
+
+                    if (num_passo % estride == 0) {
+                        double s = std::sin(y[2]);
+                        double c = std::cos(y[2]);
+                        saida[gravados++] = {
+                            lambda, y[0], y[1], y[2], y[3],
+                            y[1] * s * std::cos(y[3]),
+                            y[1] * s * std::sin(y[3]),
+                            y[1] * c};
+                    }
+
+                    passo_rk4_inplace(metrica_, y.data(), passo_);
+                    lambda += passo_;
+                    num_passo++;
+                }
+                arena.num_pontos[p] = gravados;
+            }
+        };
+
+        num_threads = std::max(1, std::min(num_threads, n));
+        if (num_threads == 1) {
+            trabalhador(0, n);
+        } else {
+            std::vector<std::thread> threads;
+            int bloco = (n + num_threads - 1) / num_threads;
+            for (int t = 0; t < num_threads; t++) {
+                int p0 = t * bloco;
+                int p1 = std::min(n, p0 + bloco);
+                if (p0 < p1) threads.emplace_back(trabalhador, p0, p1);
+            }
+            for (auto& th : threads) th.join();
+        }
+    }
+
     // Criar condições iniciais para fóton
     EstadoGeodesica foton_inicial(
         double r, double theta, double phi,
@@ -144,6 +144,125 @@ public:
     double parametro_spin() const { return a_; }
     double spin_adimensional() const { return spin_; }
     double massa_kg() const { return massa_kg_; }
+
+    // Sigma e Delta expostos para o integrador de geodésicas
+    double sigma(double r, double theta) const { return Sigma(r, theta); }
+    double delta(double r) const { return Delta(r); }
+};
+
+// ============================================================
+// GEODÉSICAS NULAS EM KERR (FORMA DE PRIMEIRA ORDEM)
+// ============================================================
+
+// Com as três constantes de movimento — energia E, momento angular
+// axial Lz e constante de Carter Q — as geodésicas de Kerr separam em
+// potenciais radiais e polares (forma de Bardeen-Press-Teukolsky, com
+// o termo de norma μ² = −g(u,u) mantido porque o lançamento do
+// traçador satura u_r e fica super-nulo; μ² = 0 recai no fóton exato):
+//
+//   (Σ dr/dλ)² = R(r),  R = [E(r²+a²) − aLz]² − Δ[(Lz−aE)² + Q + μ²r²]
+//   (Σ dθ/dλ)² = Θ(θ),  Θ = Q − cos²θ[Lz²/sin²θ + a²(μ² − E²)]
+//    Σ dφ/dλ = Lz/sin²θ − aE + a[E(r²+a²) − aLz]/Δ
+//    Σ dt/dλ = a(Lz − aE sin²θ) + (r²+a²)[E(r²+a²) − aLz]/Δ
+//
+// Em vez de avançar ±√R e ±√Θ com troca manual de sinal, o integrador
+// evolui os momentos separados p_r ≡ Σ dr/dλ e p_θ ≡ Σ dθ/dλ pelas
+// derivadas exatas dp_r/dλ = R′(r)/2Σ e dp_θ/dλ = Θ′(θ)/2Σ — isso
+// preserva p_r² − R e p_θ² − Θ identicamente, atravessa os pontos de
+// retorno sem caso especial e não congela um raio lançado exatamente
+// num ponto de retorno radial (p_r = 0, o caso de todo pixel cujo u_r
+// satura em zero no lançamento): ele recebe o empurrão R′/2Σ, o mesmo
+// termo centrífugo do caminho de segunda ordem.
+struct EstadoKerr {
+    double t, r, theta, phi;
+    double p_r, p_theta;     // Σ dr/dλ, Σ dθ/dλ
+    double E, Lz, Q;         // Constantes de movimento
+    double mu2;              // Norma −g(u,u) do lançamento
+};
+
+class IntegradorKerr {
+private:
+    const MetricaKerr& metrica_;
+    double a_;
+    double passo_;
+
+    // R′(r), com Δ′ = 2r − 2M
+    double d_potencial_radial(const EstadoKerr& e, double r) const {
+        double r2a2 = r * r + a_ * a_;
+        double P = e.E * r2a2 - a_ * e.Lz;
+        double LmaE = e.Lz - a_ * e.E;
+        double d_delta = 2.0 * r - 2.0 * metrica_.massa_geometrica();
+        return 4.0 * e.E * r * P -
+               d_delta * (LmaE * LmaE + e.Q + e.mu2 * r * r) -
+               metrica_.delta(r) * 2.0 * e.mu2 * r;
+    }
+
+    // Θ′(θ) = 2cosθ sinθ a²(μ² − E²) + 2cosθ Lz²/sin³θ
+    double d_potencial_polar(const EstadoKerr& e, double theta) const {
+        double c = std::cos(theta);
+        double s = std::sin(theta);
+        if (std::abs(s) < 1e-12) s = (s < 0.0) ? -1e-12 : 1e-12;
+        return 2.0 * c * s * a_ * a_ * (e.mu2 - e.E * e.E) +
+               2.0 * c * e.Lz * e.Lz / (s * s * s);
+    }
+
+    // Derivadas de (t, r, θ, φ, p_r, p_θ)
+    std::array<double, 6> derivadas(const EstadoKerr& e) const {
+        double sigma = metrica_.sigma(e.r, e.theta);
+        double delta = metrica_.delta(e.r);
+        if (std::abs(delta) < 1e-12) delta = 1e-12;
+
+        double s = std::sin(e.theta);
+        if (std::abs(s) < 1e-12) s = 1e-12;
+
+        double r2a2 = e.r * e.r + a_ * a_;
+        double P = e.E * r2a2 - a_ * e.Lz;
+
+        std::array<double, 6> d;
+        d[0] = (a_ * (e.Lz - a_ * e.E * s * s) + r2a2 * P / delta) / sigma;
+        d[1] = e.p_r / sigma;
+        d[2] = e.p_theta / sigma;
+        d[3] = (e.Lz / (s * s) - a_ * e.E + a_ * P / delta) / sigma;
+        d[4] = 0.5 * d_potencial_radial(e, e.r) / sigma;
+        d[5] = 0.5 * d_potencial_polar(e, e.theta) / sigma;
+        return d;
+    }
+
+public:
+    IntegradorKerr(const MetricaKerr& metrica, double passo = 0.01)
+        : metrica_(metrica), a_(metrica.parametro_spin()), passo_(passo) {}
+
+    // Avança um passo RK4 no estado separado
+    EstadoKerr passo_rk4(const EstadoKerr& estado) const {
+        auto avancar = [](const EstadoKerr& e,
+                          const std::array<double, 6>& d, double h) {
+            EstadoKerr n = e;
+            n.t += h * d[0];
+            n.r += h * d[1];
+            n.theta += h * d[2];
+            n.phi += h * d[3];
+            n.p_r += h * d[4];
+            n.p_theta += h * d[5];
+            return n;
+        };
+
+        auto k1 = derivadas(estado);
+        auto k2 = derivadas(avancar(estado, k1, 0.5 * passo_));
+        auto k3 = derivadas(avancar(estado, k2, 0.5 * passo_));
+        auto k4 = derivadas(avancar(estado, k3, passo_));
+
+        EstadoKerr novo = estado;
+        novo.t       += passo_ * (k1[0] + 2*k2[0] + 2*k3[0] + k4[0]) / 6.0;
+        novo.r       += passo_ * (k1[1] + 2*k2[1] + 2*k3[1] + k4[1]) / 6.0;
+        novo.theta   += passo_ * (k1[2] + 2*k2[2] + 2*k3[2] + k4[2]) / 6.0;
+        novo.phi     += passo_ * (k1[3] + 2*k2[3] + 2*k3[3] + k4[3]) / 6.0;
+        novo.p_r     += passo_ * (k1[4] + 2*k2[4] + 2*k3[4] + k4[4]) / 6.0;
+        novo.p_theta += passo_ * (k1[5] + 2*k2[5] + 2*k3[5] + k4[5]) / 6.0;
+        return novo;
+    }
+
+    void set_passo(double p) { passo_ = p; }
+    double get_passo() const { return passo_; }
 };
 
 } // namespace BuracoNegro
@@ -0,0 +1,166 @@
+// ============================================================
+// SimuladorBuracoNegro - Pool de Threads Persistente
+// Autor: Luiz Tiago Wilcke
+//
+// Threads de trabalho criadas uma vez e reutilizadas entre
+// renderizações, com despertar por variável de condição.
+// Elimina o custo de criar/juntar std::thread a cada quadro
+// em varreduras de parâmetros com centenas de renders.
+// ============================================================
+
+#ifndef POOL_THREADS_HPP
+#define POOL_THREADS_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace BuracoNegro {
+
+// ============================================================
+// CLASSE POOL DE THREADS
+// ============================================================
+
+// Modelo fork-join síncrono: executar(tarefa) acorda todas as
+// threads, cada uma roda tarefa(id_thread) uma vez, e a chamada
+// retorna quando a última termina. É exatamente o padrão do loop
+// de tiles do ray tracer, sem fila de jobs genérica.
+class PoolThreads {
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable cv_trabalho_;
+    std::condition_variable cv_pronto_;
+
+    std::function<void(int)> tarefa_;
+    long geracao_ = 0;      // Incrementa a cada lote de trabalho
+    int restantes_ = 0;     // Threads ainda executando o lote atual
+    bool encerrar_ = false;
+    bool fixar_ = false;    // Fixa cada thread num núcleo (afinidade)
+
+    // Fixa a thread t no núcleo t (módulo os núcleos disponíveis).
+    // Em nós de dois soquetes isso evita a migração de threads entre
+    // soquetes no meio do quadro, que arrasta as linhas de cache dos
+    // contadores e dos tiles pelo interconector. Só Linux; nos demais
+    // sistemas é um no-op.
+    void fixar_no_nucleo(std::thread& th, int t) {
+#ifdef __linux__
+        unsigned nucleos = std::thread::hardware_concurrency();
+        if (nucleos == 0) return;
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        CPU_SET(t % nucleos, &conjunto);
+        pthread_setaffinity_np(th.native_handle(), sizeof(conjunto),
+                               &conjunto);
+#else
+        (void)th;
+        (void)t;
+#endif
+    }
+
+    void laco_trabalhador(int id_thread) {
+        long geracao_vista = 0;
+        while (true) {
+            std::function<void(int)> tarefa;
+            {
+                std::unique_lock<std::mutex> trava(mutex_);
+                cv_trabalho_.wait(trava, [&] {
+                    return encerrar_ || geracao_ != geracao_vista;
+                });
+                if (encerrar_) return;
+                geracao_vista = geracao_;
+                tarefa = tarefa_;
+            }
+
+            tarefa(id_thread);
+
+            {
+                std::lock_guard<std::mutex> trava(mutex_);
+                if (--restantes_ == 0) {
+                    cv_pronto_.notify_one();
+                }
+            }
+        }
+    }
+
+    void parar() {
+        {
+            std::lock_guard<std::mutex> trava(mutex_);
+            encerrar_ = true;
+        }
+        cv_trabalho_.notify_all();
+        for (auto& th : threads_) {
+            th.join();
+        }
+        threads_.clear();
+        encerrar_ = false;
+    }
+
+public:
+    explicit PoolThreads(int num_threads = 0) {
+        if (num_threads > 0) {
+            redimensionar(num_threads);
+        }
+    }
+
+    ~PoolThreads() {
+        parar();
+    }
+
+    PoolThreads(const PoolThreads&) = delete;
+    PoolThreads& operator=(const PoolThreads&) = delete;
+
+    int tamanho() const {
+        return static_cast<int>(threads_.size());
+    }
+
+    // Recria as threads de trabalho. Só é chamado quando o número
+    // pedido muda; renders repetidos reutilizam as mesmas threads.
+    void redimensionar(int num_threads) {
+        if (num_threads == tamanho()) return;
+        parar();
+        for (int t = 0; t < num_threads; t++) {
+            threads_.emplace_back(&PoolThreads::laco_trabalhador, this, t);
+            if (fixar_) {
+                fixar_no_nucleo(threads_.back(), t);
+            }
+        }
+    }
+
+    // Liga/desliga a afinidade de núcleo. Se as threads já existem,
+    // elas são fixadas (ou soltas só na próxima recriação — desfazer
+    // afinidade de threads vivas não vale a complicação).
+    void set_afinidade(bool fixar) {
+        fixar_ = fixar;
+        if (fixar_) {
+            for (int t = 0; t < tamanho(); t++) {
+                fixar_no_nucleo(threads_[t], t);
+            }
+        }
+    }
+
+    // Executa tarefa(id_thread) em todas as threads e espera o término
+    void executar(const std::function<void(int)>& tarefa) {
+        {
+            std::lock_guard<std::mutex> trava(mutex_);
+            tarefa_ = tarefa;
+            restantes_ = tamanho();
+            geracao_++;
+        }
+        cv_trabalho_.notify_all();
+
+        std::unique_lock<std::mutex> trava(mutex_);
+        cv_pronto_.wait(trava, [&] { return restantes_ == 0; });
+    }
+};
+
+} // namespace BuracoNegro
+
+#endif // POOL_THREADS_HPP
@@ -14,14 +14,24 @@
 #include "kerr.hpp"
 #include "disco_acrecao.hpp"
 #include "integrador.hpp"
+#include "integrador_lote.hpp"
+#include "tabela_deflexao.hpp"
+#include "fundo_celestial.hpp"
+#include "pool_threads.hpp"
+#include "saida_png.hpp"
 #include <cmath>
+#include <algorithm>
 #include <array>
 #include <vector>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <memory>
+#include <chrono>
 
 namespace BuracoNegro {
 
@@ -55,6 +65,49 @@ struct Pixel {
     uint8_t b_byte() const { return static_cast<uint8_t>(b * 255); }
 };
 
+// ============================================================
+// FRAMEBUFFER CONTÍGUO
+// ============================================================
+
+// Imagem row-major numa única alocação, no lugar do antigo
+// vector-de-vectors (uma alocação por linha). A conversão para
+// bytes RGB8 é feita de uma vez, para gravação em bloco.
+class ImagemBuffer {
+private:
+    int largura_ = 0;
+    int altura_ = 0;
+    std::vector<Pixel> dados_;
+
+public:
+    ImagemBuffer() = default;
+    ImagemBuffer(int largura, int altura)
+        : largura_(largura), altura_(altura),
+          dados_(static_cast<size_t>(largura) * altura) {}
+
+    Pixel& em(int i, int j) { return dados_[static_cast<size_t>(j) * largura_ + i]; }
+    const Pixel& em(int i, int j) const { return dados_[static_cast<size_t>(j) * largura_ + i]; }
+
+    int largura() const { return largura_; }
+    int altura() const { return altura_; }
+    bool vazia() const { return dados_.empty(); }
+
+    Pixel* dados() { return dados_.data(); }
+    const Pixel* dados() const { return dados_.data(); }
+
+    // Converte o buffer inteiro para RGB8 intercalado (com clamp)
+    std::vector<uint8_t> para_bytes() const {
+        std::vector<uint8_t> bytes(dados_.size() * 3);
+        for (size_t k = 0; k < dados_.size(); k++) {
+            Pixel p = dados_[k];
+            p.clamp();
+            bytes[3 * k]     = p.r_byte();
+            bytes[3 * k + 1] = p.g_byte();
+            bytes[3 * k + 2] = p.b_byte();
+        }
+        return bytes;
+    }
+};
+
 // Configuração da câmera
 struct Camera {
     double r_observador;    // Distância do observador ao BH
@@ -72,15 +125,203 @@ struct Camera {
           largura(w), altura(h) {}
 };
 
-// Resultado de um raio traçado
+// ============================================================
+// INSTRUMENTAÇÃO DE DESEMPENHO
+// ============================================================
+
+// Estatísticas estruturadas de uma renderização, emitidas em JSON
+// ao lado da imagem para comparação entre máquinas e otimizações.
+struct EstatisticasRender {
+    double tempo_setup = 0.0;        // Construção de tabelas etc. (s)
+    double tempo_tracado = 0.0;      // Loop paralelo de raios (s)
+    double tempo_codificacao = 0.0;  // Gravação da imagem (s)
+
+    int pixels = 0;
+    int pixels_aa = 0;               // Pixels de borda re-amostrados
+    long long total_passos = 0;
+    long long avaliacoes_derivadas = 0;  // 4 por passo RK4, 7 por RK45
+
+    std::vector<long long> passos_por_thread;
+    std::vector<double> tempo_ocupado_por_thread;  // Busy time (s)
+
+    // Histograma de ResultadoRaio::passos em buckets de potência de 2:
+    // bucket k conta raios com passos em [2^k, 2^(k+1))
+    std::array<long long, 16> histograma_passos{};
+
+    bool salvar_json(const std::string& caminho) const {
+        std::ofstream arquivo(caminho);
+        if (!arquivo.is_open()) return false;
+
+        arquivo << "{\n";
+        arquivo << "  \"tempo_setup_s\": " << tempo_setup << ",\n";
+        arquivo << "  \"tempo_tracado_s\": " << tempo_tracado << ",\n";
+        arquivo << "  \"tempo_codificacao_s\": " << tempo_codificacao << ",\n";
+        arquivo << "  \"pixels\": " << pixels << ",\n";
+        arquivo << "  \"pixels_aa\": " << pixels_aa << ",\n";
+        arquivo << "  \"total_passos\": " << total_passos << ",\n";
+        arquivo << "  \"avaliacoes_derivadas\": " << avaliacoes_derivadas << ",\n";
+
+        arquivo << "  \"passos_por_thread\": [";
+        for (size_t t = 0; t < passos_por_thread.size(); t++) {
+            arquivo << (t ? ", " : "") << passos_por_thread[t];
+        }
+        arquivo << "],\n";
+
+        arquivo << "  \"tempo_ocupado_por_thread_s\": [";
+        for (size_t t = 0; t < tempo_ocupado_por_thread.size(); t++) {
+            arquivo << (t ? ", " : "") << tempo_ocupado_por_thread[t];
+        }
+        arquivo << "],\n";
+
+        arquivo << "  \"histograma_passos\": [";
+        for (size_t k = 0; k < histograma_passos.size(); k++) {
+            arquivo << (k ? ", " : "") << histograma_passos[k];
+        }
+        arquivo << "]\n";
+
+        arquivo << "}\n";
+        return arquivo.good();
+    }
+};
+
+// Planos de metadados por pixel capturados durante o traçado, para
+// exportação binária (destino, raio de impacto e passos por raio).
+// Substitui as builds de debug instrumentadas mantidas à mão.
+struct MapaRaios {
+    int largura = 0;
+    int altura = 0;
+    std::vector<uint8_t> destino;
+    std::vector<float> r_impacto;
+    std::vector<int32_t> passos;
+
+    void redimensionar(int l, int a) {
+        largura = l;
+        altura = a;
+        size_t n = static_cast<size_t>(l) * a;
+        destino.assign(n, 0);
+        r_impacto.assign(n, 0.0f);
+        passos.assign(n, 0);
+    }
+
+    bool vazio() const { return destino.empty(); }
+};
+
+// Cache do desfecho geodésico de cada pixel, para re-shading: varrer
+// um parâmetro do disco (taxa de Eddington, modo espectral) não muda
+// nenhuma trajetória — a geometria depende só de massa, spin, câmera
+// e integrador — então o quadro seguinte só precisa de destino,
+// r/cos ξ de impacto e direção de fuga, não de re-integrar nada. O
+// arquivo é endereçado pela chave da geometria (chave_geometria), o
+// que o torna válido entre processos: se a chave bate, o cache serve.
+// Layout little-endian: "BNGEO001" | uint32 largura, altura |
+// uint64 chave | planos destino (uint8), r_impacto, cos_xi (float32),
+// theta_fuga, phi_fuga (float64).
+struct CacheGeodesicas {
+    uint64_t chave = 0;
+    int largura = 0;
+    int altura = 0;
+    std::vector<uint8_t> destino;
+    std::vector<float> r_impacto;
+    std::vector<float> cos_xi;
+    // As direções de fuga ficam em double: o grid de fundo é uma função
+    // de borda dura dos ângulos, e o arredondamento de float32 troca
+    // pixels de linha perto do anel de fótons. O disco é suave em
+    // (r, cos ξ), então float32 basta para os dois planos de impacto.
+    std::vector<double> theta_fuga;
+    std::vector<double> phi_fuga;
+
+    void redimensionar(int l, int a) {
+        largura = l;
+        altura = a;
+        size_t n = static_cast<size_t>(l) * a;
+        destino.assign(n, 0);
+        r_impacto.assign(n, 0.0f);
+        cos_xi.assign(n, 0.0f);
+        theta_fuga.assign(n, 0.0);
+        phi_fuga.assign(n, 0.0);
+    }
+
+    bool vazio() const { return destino.empty(); }
+
+    bool salvar(const std::string& caminho) const {
+        std::ofstream arquivo(caminho, std::ios::binary);
+        if (!arquivo.is_open()) return false;
+
+        uint32_t dims[2] = {static_cast<uint32_t>(largura),
+                            static_cast<uint32_t>(altura)};
+        arquivo.write("BNGEO001", 8);
+        arquivo.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+        arquivo.write(reinterpret_cast<const char*>(&chave),
+                      sizeof(chave));
+
+        size_t n = destino.size();
+        arquivo.write(reinterpret_cast<const char*>(destino.data()),
+                      static_cast<std::streamsize>(n));
+        for (const std::vector<float>* plano : {&r_impacto, &cos_xi}) {
+            arquivo.write(
+                reinterpret_cast<const char*>(plano->data()),
+                static_cast<std::streamsize>(n * sizeof(float)));
+        }
+        for (const std::vector<double>* plano : {&theta_fuga, &phi_fuga}) {
+            arquivo.write(
+                reinterpret_cast<const char*>(plano->data()),
+                static_cast<std::streamsize>(n * sizeof(double)));
+        }
+        arquivo.close();
+        return arquivo.good();
+    }
+
+    // Carrega e valida: magia, dimensões e chave precisam bater com a
+    // geometria corrente, senão o arquivo é de outra cena e não serve
+    bool carregar(const std::string& caminho, uint64_t chave_esperada,
+                  int l, int a) {
+        std::ifstream arquivo(caminho, std::ios::binary);
+        if (!arquivo.is_open()) return false;
+
+        char magia[8];
+        uint32_t dims[2];
+        uint64_t chave_lida = 0;
+        arquivo.read(magia, 8);
+        arquivo.read(reinterpret_cast<char*>(dims), sizeof(dims));
+        arquivo.read(reinterpret_cast<char*>(&chave_lida),
+                     sizeof(chave_lida));
+        if (!arquivo.good() ||
+            std::string(magia, 8) != "BNGEO001" ||
+            dims[0] != static_cast<uint32_t>(l) ||
+            dims[1] != static_cast<uint32_t>(a) ||
+            chave_lida != chave_esperada) {
+            return false;
+        }
+
+        redimensionar(l, a);
+        chave = chave_lida;
+        size_t n = destino.size();
+        arquivo.read(reinterpret_cast<char*>(destino.data()),
+                     static_cast<std::streamsize>(n));
+        for (std::vector<float>* plano : {&r_impacto, &cos_xi}) {
+            arquivo.read(reinterpret_cast<char*>(plano->data()),
+                         static_cast<std::streamsize>(n * sizeof(float)));
+        }
+        for (std::vector<double>* plano : {&theta_fuga, &phi_fuga}) {
+            arquivo.read(reinterpret_cast<char*>(plano->data()),
+                         static_cast<std::streamsize>(n * sizeof(double)));
+        }
+        return arquivo.good();
+    }
+};
+
+// Resultado de um raio traçado. Para INFINITO, theta/phi_impacto
+// guardam a direção assintótica de fuga (a usada no mapa de fundo);
+// cos_xi é o cosseno de beaming passado ao disco num impacto.
 struct ResultadoRaio {
     enum Destino { HORIZONTE, DISCO, INFINITO, ERRO };
-    Destino destino;
-    double r_impacto;       // Raio onde atingiu (disco) ou parou
-    double phi_impacto;     // Ângulo phi no impacto
-    double theta_impacto;   // Ângulo theta no impacto
-    int passos;             // Número de passos de integração
-    Pixel cor;              // Cor resultante
+    Destino destino = INFINITO;
+    double r_impacto = 0.0;     // Raio onde atingiu (disco) ou parou
+    double phi_impacto = 0.0;   // Ângulo phi no impacto
+    double theta_impacto = 0.0; // Ângulo theta no impacto
+    double cos_xi = 0.0;        // Beaming no impacto (só DISCO)
+    int passos = 0;             // Número de passos de integração
+    Pixel cor;                  // Cor resultante
 };
 
 // ============================================================
@@ -93,28 +334,662 @@ private:
     DiscoAcrecao disco_;
     Camera camera_;
     double rs_;             // Raio de Schwarzschild
+
+    // Backend de Kerr (criado apenas quando spin > 0, para que o
+    // caminho de Schwarzschild não pague nada pela rotação)
+    double spin_ = 0.0;
+    std::unique_ptr<MetricaKerr> metrica_kerr_;
     
     // Parâmetros de integração
     double passo_inicial_ = 0.1;
     int max_passos_ = 10000;
     double tolerancia_horizonte_ = 1.001;
+
+    // Carta de Eddington-Finkelstein entrante no traçado escalar RK4:
+    // regular no horizonte, a captura fecha em poucos passos
+    bool usar_ef_ = false;
+
+    // Precisão mista no modo lote: estágios RK4 em float32 enquanto
+    // todas as lanes do lote estão além do raio de promoção (em rs)
+    bool usar_f32_ = false;
+    double raio_promocao_ = 20.0;
+
+    // Integração adaptativa RK45 (Dormand-Prince)
+    bool usar_rk45_ = false;
+    double tolerancia_rk45_ = 1e-6;
     
-    // Textura de fundo (grid celestial)
+    // Textura de fundo (grid celestial), rasterizada na primeira
+    // renderização ou carregada de um mapa de céu do usuário
     bool usar_fundo_ = true;
+    FundoCelestial fundo_;
+
+    // Tabela de deflexão (atalho 1D válido apenas para spin = 0)
+    bool usar_tabela_ = false;
+    TabelaDeflexao tabela_;
+
+    // Traçado em lotes SoA (spin = 0): os raios de cada tile são
+    // ordenados por custo previsto e integrados TAM_LOTE por vez
+    bool usar_lote_ = false;
+
+    // Captura dos planos de metadados por pixel durante o traçado
+    bool capturar_mapa_ = false;
+    MapaRaios mapa_;
+
+    // Captura do desfecho geodésico por pixel, para re-shading de
+    // varreduras de parâmetros do disco sem re-integrar
+    bool capturar_cache_ = false;
+    CacheGeodesicas cache_;
+
+    // Anti-aliasing adaptativo: amostras extras com jitter apenas nos
+    // pixels de borda (silhueta, anel de fótons, limbo do disco)
+    bool usar_aa_ = false;
+    int amostras_aa_ = 4;
+    double limiar_contraste_aa_ = 0.15;
     
     // Multithreading
+    // A imagem é dividida em tiles quadrados distribuídos dinamicamente:
+    // cada thread retira o próximo tile da fila atômica quando termina o
+    // anterior, de modo que raios caros (anel de fótons) não deixam os
+    // outros núcleos ociosos como acontecia com blocos fixos de linhas.
+    static constexpr int TAMANHO_TILE = 32;
     int num_threads_ = 4;
+    PoolThreads pool_;  // Threads persistentes entre renderizações
     std::mutex mutex_progresso_;
-    std::atomic<int> linhas_processadas_{0};
+    int total_tiles_ = 1;
+
+    // Progresso por thread, cada contador na sua própria linha de
+    // cache: os trabalhadores só incrementam o próprio e a leitura
+    // agrega — um contador compartilhado quicava entre soquetes a
+    // cada tile nos nós de dois soquetes da farm
+    struct alignas(64) ContadorProgresso {
+        std::atomic<long long> tiles{0};
+    };
+    std::unique_ptr<ContadorProgresso[]> progresso_threads_;
+    int num_contadores_ = 0;
+    std::vector<long long> passos_por_thread_;
+    EstatisticasRender stats_;
+
+    // Percorre a grade largura x altura pela fila de tiles, chamando
+    // por_tile(i0, j0, i1, j1, id_thread, histograma) -> passos gastos
+    // no tile. O histograma por thread é do próprio callback (bucket k
+    // conta raios com passos em [2^k, 2^(k+1))). Alimenta as
+    // estatísticas: passos e tempo ocupado por thread (medido por tile).
+    template <typename FuncaoTile>
+    void processar_tiles(int largura, int altura, FuncaoTile&& por_tile) {
+        int tiles_x = (largura + TAMANHO_TILE - 1) / TAMANHO_TILE;
+        int tiles_y = (altura + TAMANHO_TILE - 1) / TAMANHO_TILE;
+        total_tiles_ = tiles_x * tiles_y;
+        if (num_contadores_ != num_threads_) {
+            progresso_threads_ =
+                std::make_unique<ContadorProgresso[]>(num_threads_);
+            num_contadores_ = num_threads_;
+        }
+        for (int t = 0; t < num_contadores_; t++) {
+            progresso_threads_[t].tiles.store(0, std::memory_order_relaxed);
+        }
+
+        std::atomic<int> proximo_tile{0};
+        passos_por_thread_.assign(num_threads_, 0);
+        stats_.tempo_ocupado_por_thread.assign(num_threads_, 0.0);
+        std::vector<std::array<long long, 16>> histogramas(num_threads_);
+
+        auto trabalhador = [&](int id_thread) {
+            long long passos_locais = 0;
+            double ocupado = 0.0;
+            auto& histograma = histogramas[id_thread];
+            histograma.fill(0);
+
+            int tile;
+            while ((tile = proximo_tile.fetch_add(1)) < total_tiles_) {
+                auto t0 = std::chrono::steady_clock::now();
+
+                int i0 = (tile % tiles_x) * TAMANHO_TILE;
+                int j0 = (tile / tiles_x) * TAMANHO_TILE;
+                int i1 = std::min(i0 + TAMANHO_TILE, largura);
+                int j1 = std::min(j0 + TAMANHO_TILE, altura);
+
+                passos_locais += por_tile(i0, j0, i1, j1, id_thread,
+                                          histograma);
+                progresso_threads_[id_thread].tiles.fetch_add(
+                    1, std::memory_order_relaxed);
+
+                ocupado += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - t0).count();
+            }
+            passos_por_thread_[id_thread] = passos_locais;
+            stats_.tempo_ocupado_por_thread[id_thread] = ocupado;
+        };
+
+        // As threads do pool sobrevivem entre renders: varreduras de
+        // parâmetros não pagam criação/join de thread por quadro
+        pool_.redimensionar(num_threads_);
+        pool_.executar(trabalhador);
+
+        // Consolida estatísticas desta grade
+        stats_.pixels += largura * altura;
+        stats_.passos_por_thread = passos_por_thread_;
+        for (int t = 0; t < num_threads_; t++) {
+            stats_.total_passos += passos_por_thread_[t];
+            for (int k = 0; k < 16; k++) {
+                stats_.histograma_passos[k] += histogramas[t][k];
+            }
+        }
+    }
+
+    // Variante pixel a pixel do escalonador: por_pixel(i, j, id_thread)
+    // -> passos gastos no raio. Usada por todos os modos de
+    // renderização que traçam um raio por vez.
+    template <typename Funcao>
+    void processar_grade(int largura, int altura, Funcao&& por_pixel) {
+        processar_tiles(largura, altura,
+            [&](int i0, int j0, int i1, int j1, int id_thread,
+                std::array<long long, 16>& histograma) {
+                long long passos_locais = 0;
+                for (int j = j0; j < j1; j++) {
+                    for (int i = i0; i < i1; i++) {
+                        long long passos = por_pixel(i, j, id_thread);
+                        passos_locais += passos;
+
+                        int bucket = 0;
+                        while ((1LL << (bucket + 1)) <= passos + 1 &&
+                               bucket < 15) {
+                            bucket++;
+                        }
+                        histograma[bucket]++;
+                    }
+                }
+                return passos_locais;
+            });
+    }
+
+    // Estado bruto inicial (t, r, θ, φ, u_t, u_r, u_θ, u_φ) do fóton
+    // lançado com deslocamentos (alfa, beta) — a mesma conta do início
+    // de tracar_raio, compartilhada pelo caminho em lote
+    std::array<double, 8> lancar_raio(double alfa, double beta) const {
+        double r0 = camera_.r_observador;
+        double theta0 = camera_.theta_observador;
+        double f = 1.0 - rs_ / r0;
+
+        double u_t = 1.0 / f;
+        double u_theta = beta / r0;
+        double u_phi = alfa / (r0 * std::sin(theta0));
+
+        double termo1 = f * u_t * u_t;
+        double termo2 = r0 * r0 * u_theta * u_theta;
+        double termo3 = r0 * r0 * std::sin(theta0) * std::sin(theta0) *
+                        u_phi * u_phi;
+        double u_r = -std::sqrt(std::max(0.0,
+            f * (termo1 - termo2 - termo3)));
+
+        return {0.0, r0, theta0, 0.0, u_t, u_r, u_theta, u_phi};
+    }
+
+    // Guardas do teste de cruzamento por troca de sinal: num passo
+    // confiável θ muda pouco, então uma troca de sinal com |Δθ| acima
+    // de SALTO_MAX_CRUZAMENTO não é um cruzamento — é o RK4 de passo
+    // fixo explodindo num lançamento quase polar, e bisectar esse passo
+    // devolve um "impacto" em raio arbitrário. Pelo mesmo motivo o
+    // estado refinado só é aceito finito e com θ de fato sobre o plano
+    // (a bisseção de um cruzamento genuíno deixa o resíduo em
+    // |Δθ|/2⁸ ≪ TOL_THETA_CRUZAMENTO).
+    static constexpr double SALTO_MAX_CRUZAMENTO = 0.5;   // rad
+    static constexpr double TOL_THETA_CRUZAMENTO = 0.01;  // rad
+
+    // Refina o ponto em que o último passo cruzou o plano do disco:
+    // palpite secante na fração do passo seguido de bisseção,
+    // re-integrando de y_ant com passo parcial. Custa ~9 passos RK4 e
+    // só roda quando θ − π/2 trocou de sinal, então a precisão do
+    // impacto deixa de depender do tamanho do passo global.
+    std::array<double, 8> refinar_cruzamento(
+        const std::array<double, 8>& y_ant, double h,
+        double d_ant, double d_novo) const {
+        double lo = 0.0, hi = 1.0;
+        double s = d_ant / (d_ant - d_novo);  // Palpite secante
+        s = std::min(0.99, std::max(0.01, s));
+
+        std::array<double, 8> y_m = y_ant;
+        for (int it = 0; it < 8; it++) {
+            y_m = y_ant;
+            if (usar_ef_ && !usar_rk45_) {
+                passo_rk4_ef_inplace(metrica_, y_m.data(), h * s);
+            } else {
+                passo_rk4_inplace(metrica_, y_m.data(), h * s);
+            }
+            double d = y_m[2] - M_PI / 2.0;
+            if ((d > 0.0) == (d_ant > 0.0)) {
+                lo = s;
+            } else {
+                hi = s;
+            }
+            s = 0.5 * (lo + hi);
+        }
+        y_m = y_ant;
+        if (usar_ef_ && !usar_rk45_) {
+            passo_rk4_ef_inplace(metrica_, y_m.data(), h * s);
+        } else {
+            passo_rk4_inplace(metrica_, y_m.data(), h * s);
+        }
+        return y_m;
+    }
+
+    // Prova de que um raio capturado (b < b_crit) não cruza o plano do
+    // disco fora da borda interna, e portanto pode virar preto sem
+    // integrar. O ângulo varrido no plano orbital de r0 até a borda
+    // interna vem da quadratura de dψ/dr = b / (r² √(1 − b² V(r))) —
+    // V é o potencial_efetivo de fótons com L = 1 — e é comparado com
+    // o ângulo do primeiro cruzamento equatorial. Margem de 5% para a
+    // quadratura nunca subestimar um cruzamento real.
+    bool captura_sem_disco(double b, double u_theta, double w) const {
+        double r0 = camera_.r_observador;
+        double theta0 = camera_.theta_observador;
+        double s0 = std::sin(theta0);
+        double c0 = std::cos(theta0);
+
+        // Mergulho radial puro: nunca sai do raio de visada
+        if (w < 1e-15) return true;
+
+        // Primeiro cruzamento do plano equatorial no plano orbital:
+        // z(ψ) ∝ cosψ nz + sinψ mz, com n̂ radial e m̂ transversal
+        // (a mesma base de tracar_raio_tabela)
+        double nz = c0;
+        double mz = -u_theta * s0 / w;
+        double psi_cruz = std::atan2(-nz, mz);
+        if (psi_cruz <= 0.0) psi_cruz += M_PI;
+
+        // Ângulo varrido até r cair abaixo da borda interna do disco
+        // (abaixo dela o cruzamento não ilumina nada), em log r
+        double r_int = disco_.raio_interno();
+        const int n = 96;
+        double lr_int = std::log(r_int);
+        double dlr = (std::log(r0) - lr_int) / n;
+
+        double dpsi = 0.0;
+        for (int k = 0; k < n; k++) {
+            double r = std::exp(lr_int + (k + 0.5) * dlr);
+            double raiz = 1.0 -
+                b * b * metrica_.potencial_efetivo(r, 1.0, false);
+            if (raiz <= 0.0) return false;  // Não deveria com b < b_crit
+            dpsi += b / (r * std::sqrt(raiz)) * dlr;
+        }
+        return dpsi * 1.05 < psi_cruz;
+    }
+
+    // Fator do passo grosso da classificação do modo lote
+    static constexpr int FATOR_PREVISAO = 8;
+
+    // Classificação barata de um raio: integra com passo FATOR_PREVISAO
+    // vezes mais grosso e devolve quantos passos grossos levou até
+    // terminar. Não serve como trajetória (erra o anel de fótons de
+    // propósito), mas ordena bem os raios por tempo de vida: mergulho
+    // direto no horizonte termina em dezenas de passos, fuga para o
+    // infinito em centenas, e o anel de fótons satura o teto.
+    int prever_passos(double alfa, double beta) const {
+        std::array<double, 8> y = lancar_raio(alfa, beta);
+        double& r = y[1];
+        double& theta = y[2];
+
+        int teto = max_passos_ / FATOR_PREVISAO;
+        double d_ant = theta - M_PI / 2.0;
+        for (int i = 0; i < teto; i++) {
+            double d_novo = theta - M_PI / 2.0;
+            if (r < rs_ * tolerancia_horizonte_ ||
+                r > camera_.r_observador * 2.0 ||
+                (i > 0 && (d_ant > 0.0) != (d_novo > 0.0) &&
+                 std::abs(d_novo - d_ant) < SALTO_MAX_CRUZAMENTO &&
+                 disco_.no_disco(r))) {
+                return i;
+            }
+            d_ant = d_novo;
+            double passo = FATOR_PREVISAO * passo_inicial_ *
+                           std::sqrt(r / rs_);
+            passo_rk4_inplace(metrica_, y.data(), passo);
+
+            if (theta < 0.0) {
+                theta = -theta;
+                y[6] = -y[6];
+            }
+            if (theta > M_PI) {
+                theta = 2.0 * M_PI - theta;
+                y[6] = -y[6];
+            }
+        }
+        return teto;
+    }
+
+    // Traçado coerente de um tile: o passe de classificação prevê o
+    // custo de cada raio, os pixels são ordenados pelo custo previsto
+    // e integrados TAM_LOTE por vez no integrador SoA. Lanes de um
+    // mesmo lote se aposentam quase juntas, então o loop vetorizado
+    // não fica girando lanes mortas à espera de um único raio caro —
+    // que é o que a ordem de varredura ingênua produziria, com pixels
+    // vizinhos indo de 50 passos (HORIZONTE) a 5000 (anel de fótons).
+    long long tracar_tile_lote(int i0, int j0, int i1, int j1,
+                               ImagemBuffer& imagem,
+                               std::vector<ResultadoRaio::Destino>* destinos,
+                               std::array<long long, 16>& histograma) {
+        int largura = imagem.largura();
+        int altura = imagem.altura();
+        int n = (i1 - i0) * (j1 - j0);
+
+        auto alfa_de = [&](int i) {
+            return (i - largura / 2.0) / largura *
+                   camera_.fov_horizontal * camera_.r_observador;
+        };
+        auto beta_de = [&](int j) {
+            return (j - altura / 2.0) / altura *
+                   camera_.fov_vertical * camera_.r_observador;
+        };
+
+        // Passe 1: classificação e ordenação por custo previsto
+        struct RaioTile { int i, j, custo; };
+        std::vector<RaioTile> raios;
+        raios.reserve(n);
+        long long passos_totais = 0;
+
+        for (int j = j0; j < j1; j++) {
+            for (int i = i0; i < i1; i++) {
+                int custo = prever_passos(alfa_de(i), beta_de(j));
+                passos_totais += custo;  // Passos grossos também contam
+                raios.push_back({i, j, custo});
+            }
+        }
+        std::sort(raios.begin(), raios.end(),
+                  [](const RaioTile& a, const RaioTile& b) {
+                      return a.custo < b.custo;
+                  });
+
+        // Passe 2: integração em lotes na ordem de custo
+        IntegradorLote integrador(metrica_);
+
+        // Aquém deste raio o lote volta a f64 (o estado mestre é
+        // sempre double, então o refinamento de impacto e o shading
+        // não mudam; só o erro de truncamento dos incrementos f32
+        // entra na trajetória de campo distante)
+        double r_promocao = raio_promocao_ * rs_;
+        for (int base = 0; base < n; base += TAM_LOTE) {
+            int lanes = std::min(TAM_LOTE, n - base);
+
+            LoteGeodesicas lote;
+            int pix_i[TAM_LOTE], pix_j[TAM_LOTE];
+            int passos_lane[TAM_LOTE] = {};
+            double d_ant[TAM_LOTE] = {};
+            double h_ant[TAM_LOTE] = {};
+            double y_ant[8][TAM_LOTE];
+            for (int l = 0; l < TAM_LOTE; l++) {
+                lote.ativo[l] = false;
+            }
+            for (int l = 0; l < lanes; l++) {
+                pix_i[l] = raios[base + l].i;
+                pix_j[l] = raios[base + l].j;
+                std::array<double, 8> y =
+                    lancar_raio(alfa_de(pix_i[l]), beta_de(pix_j[l]));
+                lote.carregar(l, EstadoGeodesica::de_array(y),
+                              passo_inicial_);
+                d_ant[l] = y[2] - M_PI / 2.0;
+            }
+
+            auto finalizar = [&](int l, ResultadoRaio::Destino destino,
+                                 const Pixel& cor, double r_impacto) {
+                imagem.em(pix_i[l], pix_j[l]) = cor;
+                size_t idx = static_cast<size_t>(pix_j[l]) * largura +
+                             pix_i[l];
+                if (destinos) {
+                    (*destinos)[idx] = destino;
+                }
+                if (capturar_mapa_) {
+                    mapa_.destino[idx] = static_cast<uint8_t>(destino);
+                    mapa_.r_impacto[idx] =
+                        static_cast<float>(r_impacto);
+                    mapa_.passos[idx] = passos_lane[l];
+                }
+
+                int bucket = 0;
+                while ((1LL << (bucket + 1)) <= passos_lane[l] + 1 &&
+                       bucket < 15) {
+                    bucket++;
+                }
+                histograma[bucket]++;
+                passos_totais += passos_lane[l];
+                lote.ativo[l] = false;
+            };
+
+            int vivos = lanes;
+            for (int passo = 0; passo < max_passos_ && vivos > 0;
+                 passo++) {
+                // Término e shading por lane, com os mesmos testes do
+                // caminho escalar
+                for (int l = 0; l < lanes; l++) {
+                    if (!lote.ativo[l]) continue;
+                    double r = lote.r(l);
+                    double theta = lote.theta(l);
+
+                    if (r < rs_ * tolerancia_horizonte_) {
+                        finalizar(l, ResultadoRaio::HORIZONTE,
+                                  Pixel(0.0, 0.0, 0.0), r);
+                        vivos--;
+                        continue;
+                    }
+
+                    // Cruzamento do plano do disco por troca de sinal
+                    // de θ − π/2, refinado e guardado contra passos
+                    // estourados como no caminho escalar
+                    double d_novo = theta - M_PI / 2.0;
+                    if (passos_lane[l] > 0 &&
+                        (d_ant[l] > 0.0) != (d_novo > 0.0) &&
+                        std::abs(d_novo - d_ant[l]) <
+                            SALTO_MAX_CRUZAMENTO) {
+                        std::array<double, 8> ya;
+                        for (int v = 0; v < 8; v++) {
+                            ya[v] = y_ant[v][l];
+                        }
+                        std::array<double, 8> y_c = refinar_cruzamento(
+                            ya, h_ant[l], d_ant[l], d_novo);
+
+                        if (std::isfinite(y_c[1]) &&
+                            std::abs(y_c[2] - M_PI / 2.0) <
+                                TOL_THETA_CRUZAMENTO &&
+                            disco_.no_disco(y_c[1])) {
+                            CorRGB cor_disco =
+                                disco_.intensidade_observada(
+                                    y_c[1],
+                                    cos_doppler(y_c[1], y_c[2], y_c[5],
+                                                y_c[6], y_c[7]));
+                            finalizar(l, ResultadoRaio::DISCO,
+                                      Pixel(cor_disco.r, cor_disco.g,
+                                            cor_disco.b), y_c[1]);
+                            vivos--;
+                            continue;
+                        }
+                    }
+                    d_ant[l] = d_novo;
+
+                    if (r > camera_.r_observador * 2.0) {
+                        Pixel cor = usar_fundo_
+                            ? cor_fundo(theta, lote.phi(l))
+                            : Pixel(0.02, 0.02, 0.05);
+                        finalizar(l, ResultadoRaio::INFINITO, cor, r);
+                        vivos--;
+                    } else {
+                        // Passo adaptativo por lane, como no escalar
+                        lote.passo[l] = passo_inicial_ *
+                                        std::sqrt(r / rs_);
+                    }
+                }
+                if (vivos == 0) break;
+
+                // Estado anterior por lane, para o refinamento
+                for (int l = 0; l < lanes; l++) {
+                    if (!lote.ativo[l]) continue;
+                    for (int v = 0; v < 8; v++) {
+                        y_ant[v][l] = lote.y[v][l];
+                    }
+                    h_ant[l] = lote.passo[l];
+                }
+
+                // Precisão mista: o lote inteiro avança em float32
+                // enquanto nenhuma lane ativa se aproxima do disco ou
+                // do forte campo — a ordenação por custo mantém as
+                // lanes coerentes, então a janela f32 é longa
+                bool longe = usar_f32_;
+                for (int l = 0; longe && l < lanes; l++) {
+                    if (lote.ativo[l] && lote.r(l) < r_promocao) {
+                        longe = false;
+                    }
+                }
+                if (longe) {
+                    integrador.passo_rk4_f32(lote);
+                } else {
+                    integrador.passo_rk4(lote);
+                }
+
+                for (int l = 0; l < lanes; l++) {
+                    if (!lote.ativo[l]) continue;
+                    passos_lane[l]++;
+
+                    // Mantém θ em [0, π]
+                    double& theta = lote.theta(l);
+                    if (theta < 0.0) {
+                        theta = -theta;
+                        lote.u_theta(l) = -lote.u_theta(l);
+                    }
+                    if (theta > M_PI) {
+                        theta = 2.0 * M_PI - theta;
+                        lote.u_theta(l) = -lote.u_theta(l);
+                    }
+                }
+            }
+
+            // Lanes que estouraram max_passos_
+            for (int l = 0; l < lanes; l++) {
+                if (lote.ativo[l]) {
+                    finalizar(l, ResultadoRaio::ERRO,
+                              Pixel(1.0, 0.0, 1.0), lote.r(l));
+                }
+            }
+        }
+        return passos_totais;
+    }
+
+    // Constrói/reconstrói a tabela de deflexão para a câmera atual
+    void preparar_tabela() {
+        double alfa_max = 0.5 * camera_.fov_horizontal * camera_.r_observador;
+        double beta_max = 0.5 * camera_.fov_vertical * camera_.r_observador;
+        double b_canto = camera_.r_observador *
+            std::sqrt(alfa_max * alfa_max + beta_max * beta_max) * 1.05;
+        if (!tabela_.valida(rs_, camera_.r_observador, b_canto)) {
+            tabela_.construir(metrica_, camera_.r_observador, b_canto,
+                              4096, passo_inicial_, max_passos_,
+                              num_threads_);
+        }
+    }
+
+    // Cosseno do ângulo entre a velocidade orbital do gás (+φ̂) e a
+    // direção de propagação física do fóton no ponto de impacto, nas
+    // componentes ortonormais locais. O traçado é reverso (câmera →
+    // disco), então o fóton real viaja no sentido oposto ao estado
+    // integrado: cos ξ = −p_φ̂ / |p|. Aceita tanto velocidades
+    // coordenadas quanto diferenças finitas do passo (a escala comum
+    // em dλ cancela na normalização).
+    double cos_doppler(double r, double theta, double u_r,
+                       double u_theta, double u_phi) const {
+        double f = std::max(1e-12, 1.0 - rs_ / r);
+        double s = std::sin(theta);
+        double p_r = u_r / std::sqrt(f);
+        double p_th = r * u_theta;
+        double p_ph = r * s * u_phi;
+        double norma = std::sqrt(p_r * p_r + p_th * p_th + p_ph * p_ph);
+        if (norma <= 0.0) return 0.0;
+        return -p_ph / norma;
+    }
+
+    // Jitter determinístico em [0, 1) por (pixel, amostra), no mesmo
+    // estilo do hash senoidal das estrelas de fundo: sem estado de RNG
+    // por thread e reprodutível entre execuções
+    static double jitter_aa(int i, int j, int s, double desloc) {
+        double v = std::sin(i * 127.1 + j * 311.7 + s * 74.7 + desloc) *
+                   43758.5453;
+        return v - std::floor(v);
+    }
+
+    // Passe de refinamento do anti-aliasing: marca como borda todo
+    // pixel cuja vizinhança 3x3 muda de destino ou cujo contraste de
+    // cor excede o limiar, e traça amostras extras com jitter só neles.
+    // Na silhueta do horizonte e no anel de fótons isso re-amostra uns
+    // poucos por cento dos pixels, com qualidade equivalente a render
+    // em resolução múltipla e reduzir.
+    void refinar_bordas(ImagemBuffer& imagem,
+                        const std::vector<ResultadoRaio::Destino>& destinos) {
+        int largura = imagem.largura();
+        int altura = imagem.altura();
+
+        auto contraste = [](const Pixel& a, const Pixel& b) {
+            return std::max({std::abs(a.r - b.r), std::abs(a.g - b.g),
+                             std::abs(a.b - b.b)});
+        };
+
+        std::vector<uint8_t> borda(static_cast<size_t>(largura) * altura, 0);
+        int num_bordas = 0;
+        for (int j = 0; j < altura; j++) {
+            for (int i = 0; i < largura; i++) {
+                size_t idx = static_cast<size_t>(j) * largura + i;
+                for (int dj = -1; dj <= 1 && !borda[idx]; dj++) {
+                    for (int di = -1; di <= 1; di++) {
+                        int ii = std::max(0, std::min(largura - 1, i + di));
+                        int jj = std::max(0, std::min(altura - 1, j + dj));
+                        size_t viz = static_cast<size_t>(jj) * largura + ii;
+                        if (destinos[viz] != destinos[idx] ||
+                            contraste(imagem.em(ii, jj), imagem.em(i, j)) >
+                                limiar_contraste_aa_) {
+                            borda[idx] = 1;
+                            num_bordas++;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        stats_.pixels_aa += num_bordas;
+
+        processar_grade(largura, altura, [&](int i, int j, int) {
+            if (!borda[static_cast<size_t>(j) * largura + i]) {
+                return 0;
+            }
+
+            Pixel acumulado = imagem.em(i, j);
+            int passos = 0;
+            for (int s = 1; s < amostras_aa_; s++) {
+                double di = jitter_aa(i, j, s, 0.0) - 0.5;
+                double dj = jitter_aa(i, j, s, 17.0) - 0.5;
+                double alfa = (i + di - largura / 2.0) / largura *
+                              camera_.fov_horizontal * camera_.r_observador;
+                double beta = (j + dj - altura / 2.0) / altura *
+                              camera_.fov_vertical * camera_.r_observador;
+
+                ResultadoRaio resultado = usar_tabela_
+                    ? tracar_raio_tabela(alfa, beta)
+                    : tracar_raio(alfa, beta);
+                acumulado = acumulado + resultado.cor;
+                passos += resultado.passos;
+            }
+            imagem.em(i, j) = acumulado * (1.0 / amostras_aa_);
+            return passos;
+        });
+    }
 
 public:
-    RayTracer(double massa_solar = 10.0, double taxa_eddington = 0.1)
+    RayTracer(double massa_solar = 10.0, double taxa_eddington = 0.1,
+              double spin = 0.0)
         : metrica_(massa_solar),
-          disco_(massa_solar, taxa_eddington),
-          camera_()
+          disco_(massa_solar, taxa_eddington, spin),
+          camera_(),
+          spin_(spin)
     {
         rs_ = metrica_.raio_schwarzschild();
         camera_.r_observador = 100.0 * rs_;
+
+        if (spin_ > 0.01) {
+            metrica_kerr_ = std::make_unique<MetricaKerr>(massa_solar, spin_);
+        }
     }
 
     // ============================================================
@@ -139,11 +1014,164 @@ public:
         num_threads_ = std::max(1, n);
     }
 
+    // Afinidade de núcleo nas threads do pool (nós NUMA da farm):
+    // cada trabalhador fica preso ao seu núcleo, então o estado quente
+    // do raio e os tiles em preenchimento não migram de soquete no
+    // meio do quadro
+    void set_afinidade(bool fixar) {
+        pool_.set_afinidade(fixar);
+    }
+
+    // Ativa o modo de tabela de deflexão (só correto para spin = 0).
+    // A tabela é (re)construída no início da próxima renderização.
+    void set_tabela_deflexao(bool usar) {
+        usar_tabela_ = usar;
+    }
+
+    // Traçado em lotes SoA com ordenação por custo previsto. Vale só
+    // para o caminho RK4 de Schwarzschild: com Kerr, tabela ou RK45 o
+    // traçado escalar continua sendo usado.
+    void set_lote(bool usar) {
+        usar_lote_ = usar;
+    }
+
+    // Carta de Eddington-Finkelstein entrante no traçado escalar de
+    // Schwarzschild (sem efeito com Kerr, RK45, tabela ou lote): os
+    // raios mergulhantes cruzam o horizonte suavemente, achatando a
+    // cauda pesada do histograma de passos
+    void set_coordenadas_ef(bool usar) {
+        usar_ef_ = usar;
+    }
+
+    // Precisão mista do modo lote: estágios RK4 em float32 no campo
+    // distante, promoção para double aquém de raio_rs — perto do
+    // horizonte e do disco interno a deflexão por passo volta a
+    // merecer 53 bits
+    void set_precisao_mista(bool usar, double raio_rs = 20.0) {
+        usar_f32_ = usar;
+        raio_promocao_ = raio_rs;
+    }
+
+    // Integração adaptativa RK45 em vez de RK4 com passo heurístico
+    void set_rk45(bool usar, double tolerancia = 1e-6) {
+        usar_rk45_ = usar;
+        tolerancia_rk45_ = tolerancia;
+    }
+
+    // Modo espectral do disco: Planck deslocado pelo shift total em
+    // vez de brilho g⁴ sobre a cor empírica
+    void set_espectral(bool usar) {
+        disco_.set_espectral(usar);
+    }
+
+    // Captura os planos de metadados por pixel (destino, r_impacto,
+    // passos) na próxima renderização, para exportação com salvar_bin
+    void set_captura_mapa(bool capturar) {
+        capturar_mapa_ = capturar;
+    }
+
+    const MapaRaios& mapa_raios() const { return mapa_; }
+
+    // Captura o desfecho geodésico por pixel na próxima renderização
+    // (desliga o modo lote nesse quadro; o custo extra é só a escrita
+    // dos planos). O cache alimenta renderizar_reshade.
+    void set_captura_cache(bool capturar) {
+        capturar_cache_ = capturar;
+    }
+
+    const CacheGeodesicas& cache_geodesicas() const { return cache_; }
+
+    // Chave da geometria corrente: tudo que muda alguma trajetória
+    // (massa, spin, câmera, integrador e modos que alteram o traçado).
+    // Parâmetros do disco e do fundo ficam de fora de propósito — são
+    // exatamente os que o re-shading pode variar de graça.
+    uint64_t chave_geometria() const {
+        uint64_t h = 1469598103934665603ull;  // FNV-1a
+        auto mistura = [&h](uint64_t bits) {
+            for (int b = 0; b < 8; b++) {
+                h ^= (bits >> (8 * b)) & 0xFFu;
+                h *= 1099511628211ull;
+            }
+        };
+        auto mistura_d = [&](double v) {
+            uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            mistura(bits);
+        };
+        mistura_d(metrica_.massa_geometrica());
+        mistura_d(spin_);
+        mistura_d(camera_.r_observador);
+        mistura_d(camera_.theta_observador);
+        mistura_d(camera_.fov_horizontal);
+        mistura_d(camera_.fov_vertical);
+        mistura_d(passo_inicial_);
+        mistura_d(tolerancia_rk45_);
+        mistura(static_cast<uint64_t>(camera_.largura));
+        mistura(static_cast<uint64_t>(camera_.altura));
+        mistura(static_cast<uint64_t>(max_passos_));
+        mistura((usar_tabela_ ? 1u : 0u) | (usar_rk45_ ? 2u : 0u) |
+                (usar_ef_ ? 4u : 0u) | (usar_lote_ ? 8u : 0u) |
+                (usar_f32_ ? 16u : 0u));
+        return h;
+    }
+
+    bool salvar_cache(const std::string& caminho) const {
+        return !cache_.vazio() && cache_.salvar(caminho);
+    }
+
+    bool carregar_cache(const std::string& caminho) {
+        return cache_.carregar(caminho, chave_geometria(),
+                               camera_.largura, camera_.altura);
+    }
+
+    // Chave de retomada do streaming: a chave da geometria estendida
+    // com o shading (disco, fundo, modo espectral). O cache geodésico
+    // ignora o disco de propósito; aqui as bandas antigas permanecem
+    // no quadro final, então qualquer mudança de cena precisa invalidar
+    uint64_t chave_cena() const {
+        uint64_t h = chave_geometria();
+        auto mistura_d = [&h](double v) {
+            uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            for (int b = 0; b < 8; b++) {
+                h ^= (bits >> (8 * b)) & 0xFFu;
+                h *= 1099511628211ull;
+            }
+        };
+        mistura_d(disco_.taxa_acrecao());
+        mistura_d(disco_.raio_interno());
+        mistura_d(disco_.raio_externo());
+        mistura_d((usar_fundo_ ? 2.0 : 0.0) +
+                  (disco_.espectral() ? 1.0 : 0.0));
+        return h;
+    }
+
+    // Mapa de céu equiretangular fornecido pelo usuário (PPM P6) no
+    // lugar do padrão procedural rasterizado
+    bool carregar_fundo(const std::string& caminho) {
+        return fundo_.carregar_ppm(caminho);
+    }
+
+    // Supersampling adaptativo: após o passe de 1 amostra/pixel, só os
+    // pixels de borda recebem amostras extras (vizinho com destino
+    // diferente ou contraste de cor acima do limiar)
+    void set_antialiasing(bool usar, int amostras = 4,
+                          double limiar_contraste = 0.15) {
+        usar_aa_ = usar;
+        amostras_aa_ = std::max(2, amostras);
+        limiar_contraste_aa_ = limiar_contraste;
+    }
+
     // ============================================================
     // TRAÇADO DE RAIO INDIVIDUAL
     // ============================================================
     
     ResultadoRaio tracar_raio(double alfa, double beta) const {
+        // Com rotação, o traçado usa o backend de Kerr
+        if (metrica_kerr_) {
+            return tracar_raio_kerr(alfa, beta);
+        }
+
         ResultadoRaio resultado;
         resultado.destino = ResultadoRaio::INFINITO;
         resultado.passos = 0;
@@ -173,224 +1201,1043 @@ public:
         // Raio para dentro (negativo)
         double u_r = -std::sqrt(std::max(0.0, u_r_sq));
         
-        // Estado inicial
-        EstadoGeodesica estado = {t0, r0, theta0, phi0, u_t, u_r, u_theta, u_phi};
-        
-        // Integrador
+        // Raio preso ao plano equatorial: u_θ = 0 com θ = π/2 se
+        // conserva exatamente, então o sistema reduzido basta (o
+        // sistema reduzido é da carta padrão, então EF segue no loop
+        // completo)
+        if ((!usar_ef_ || usar_rk45_) && u_theta == 0.0 &&
+            std::abs(theta0 - M_PI / 2.0) < 1e-9) {
+            return tracar_raio_equatorial(u_r, u_phi);
+        }
+
+        // Atalho analítico de captura: com E = f u_t = 1, o parâmetro
+        // de impacto é b = L/E = r0² w, e b < b_crit = 3√3 M garante
+        // queda no horizonte — não há ponto de retorno no potencial.
+        // Só falta provar que o raio não atravessa o disco no caminho;
+        // aí a integração inteira vira um pixel preto imediato.
+        {
+            double s0 = std::sin(theta0);
+            double w = std::sqrt(u_theta * u_theta +
+                                 s0 * s0 * u_phi * u_phi);
+            double b = r0 * r0 * w;
+            double b_crit = 3.0 * std::sqrt(3.0) *
+                            metrica_.massa_geometrica();
+            if (b < b_crit && captura_sem_disco(b, u_theta, w)) {
+                resultado.destino = ResultadoRaio::HORIZONTE;
+                resultado.r_impacto = rs_;
+                resultado.cor = Pixel(0.0, 0.0, 0.0);
+                return resultado;
+            }
+        }
+
+        // Na carta EF o estado vira (v, ...) com u_v = u_t + u_r/f; a
+        // tolerância do horizonte some porque nada diverge em r = rs
+        bool ef = usar_ef_ && !usar_rk45_;
+        if (ef) {
+            u_t += u_r / f;
+        }
+        double r_captura = ef ? rs_ : rs_ * tolerancia_horizonte_;
+
+        // Estado bruto (t, r, θ, φ, u_t, u_r, u_θ, u_φ): o loop quente
+        // opera no lugar, sem montar/desmontar EstadoGeodesica por passo
+        std::array<double, 8> y = {t0, r0, theta0, phi0,
+                                   u_t, u_r, u_theta, u_phi};
+        double& r = y[1];
+        double& theta = y[2];
+        double& phi = y[3];
+
+        // Integrador persistente só é necessário no modo RK45 (guarda
+        // o tamanho de passo proposto entre um passo e o seguinte)
         IntegradorGeodesico integrador(metrica_, passo_inicial_);
-        
+        if (usar_rk45_) {
+            // Chute inicial na escala do campo distante; o controle de
+            // erro ajusta a partir daí
+            integrador.set_passo(passo_inicial_ * std::sqrt(r0 / rs_));
+        }
+
+        // Estado do passo anterior, para detectar o cruzamento do
+        // plano do disco por troca de sinal de θ − π/2
+        std::array<double, 8> y_ant = y;
+        double h_ant = 0.0;
+        double d_ant = theta0 - M_PI / 2.0;
+
         // Loop de integração
-        double r_anterior = r0;
         for (int i = 0; i < max_passos_; i++) {
             resultado.passos = i;
-            
+
             // Verifica se atingiu o horizonte
-            if (estado.r < rs_ * tolerancia_horizonte_) {
+            if (r < r_captura) {
                 resultado.destino = ResultadoRaio::HORIZONTE;
-                resultado.r_impacto = estado.r;
+                resultado.r_impacto = r;
                 resultado.cor = Pixel(0.0, 0.0, 0.0);  // Negro absoluto
                 return resultado;
             }
-            
-            // Verifica se passou pelo plano do disco (θ ≈ π/2)
-            double theta_disco = M_PI / 2.0;
-            double delta_theta = std::abs(estado.theta - theta_disco);
-            
-            if (delta_theta < 0.01 && disco_.no_disco(estado.r)) {
-                resultado.destino = ResultadoRaio::DISCO;
-                resultado.r_impacto = estado.r;
-                resultado.phi_impacto = estado.phi;
-                resultado.theta_impacto = estado.theta;
-                
-                // Cor do disco
-                CorRGB cor_disco = disco_.intensidade_observada(estado.r, estado.phi);
-                resultado.cor = Pixel(cor_disco.r, cor_disco.g, cor_disco.b);
-                return resultado;
+
+            // Cruzou o plano do disco? Troca de sinal de θ − π/2 entre
+            // passos consecutivos (um raio rápido não salta mais por
+            // cima do plano), com o ponto exato refinado por
+            // secante/bisseção. A troca só conta num passo confiável:
+            // perto do polo o RK4 de passo fixo pode explodir e a
+            // troca de sinal do passo estourado não é cruzamento nenhum
+            double d_novo = theta - M_PI / 2.0;
+            if (i > 0 && (d_ant > 0.0) != (d_novo > 0.0) &&
+                std::abs(d_novo - d_ant) < SALTO_MAX_CRUZAMENTO) {
+                std::array<double, 8> y_c =
+                    refinar_cruzamento(y_ant, h_ant, d_ant, d_novo);
+                double r_c = y_c[1];
+
+                if (std::isfinite(r_c) &&
+                    std::abs(y_c[2] - M_PI / 2.0) < TOL_THETA_CRUZAMENTO &&
+                    disco_.no_disco(r_c)) {
+                    resultado.destino = ResultadoRaio::DISCO;
+                    resultado.r_impacto = r_c;
+                    resultado.phi_impacto = y_c[3];
+                    resultado.theta_impacto = y_c[2];
+
+                    // Cor do disco, com beaming pelo momento real
+                    resultado.cos_xi = cos_doppler(r_c, y_c[2], y_c[5],
+                                                   y_c[6], y_c[7]);
+                    CorRGB cor_disco = disco_.intensidade_observada(
+                        r_c, resultado.cos_xi);
+                    resultado.cor = Pixel(cor_disco.r, cor_disco.g,
+                                          cor_disco.b);
+                    return resultado;
+                }
             }
-            
+            d_ant = d_novo;
+
             // Verifica se escapou para infinito
-            if (estado.r > camera_.r_observador * 2.0) {
+            if (r > camera_.r_observador * 2.0) {
                 resultado.destino = ResultadoRaio::INFINITO;
-                
+                resultado.theta_impacto = theta;
+                resultado.phi_impacto = phi;
+
                 if (usar_fundo_) {
                     // Grid celestial de fundo
-                    resultado.cor = cor_fundo(estado.theta, estado.phi);
+                    resultado.cor = cor_fundo(theta, phi);
                 } else {
                     resultado.cor = Pixel(0.02, 0.02, 0.05);  // Azul escuro
                 }
                 return resultado;
             }
-            
-            // Passo adaptativo baseado na distância
-            double fator_passo = std::sqrt(estado.r / rs_);
-            integrador.set_passo(passo_inicial_ * fator_passo);
-            
-            // Integra um passo
-            r_anterior = estado.r;
-            estado = integrador.passo_rk4(estado);
-            
+
+            y_ant = y;
+            if (usar_rk45_) {
+                // Passo controlado pelo erro local (Dormand-Prince).
+                // O passo proposto serve de h para o refinamento (a
+                // re-integração RK4 retraça o mesmo trecho de perto)
+                h_ant = integrador.get_passo();
+                EstadoGeodesica estado = EstadoGeodesica::de_array(y);
+                estado = integrador.passo_adaptativo(estado, tolerancia_rk45_);
+                y = estado.como_array();
+            } else {
+                // Passo adaptativo baseado na distância, integrado no
+                // lugar com a métrica por referência
+                h_ant = passo_inicial_ * std::sqrt(r / rs_);
+                if (usar_ef_) {
+                    passo_rk4_ef_inplace(metrica_, y.data(), h_ant);
+                } else {
+                    passo_rk4_inplace(metrica_, y.data(), h_ant);
+                }
+            }
+
             // Mantém θ em [0, π]
+            if (theta < 0.0) {
+                theta = -theta;
+                y[6] = -y[6];
+            }
+            if (theta > M_PI) {
+                theta = 2.0 * M_PI - theta;
+                y[6] = -y[6];
+            }
+        }
+        
+        resultado.destino = ResultadoRaio::ERRO;
+        resultado.cor = Pixel(1.0, 0.0, 1.0);  // Magenta = erro
+        return resultado;
+    }
+
+    // ============================================================
+    // TRAÇADO DE RAIO EM KERR
+    // ============================================================
+
+    // Traçado com as equações de primeira ordem de Kerr: as três
+    // constantes (E, Lz, Q) são extraídas das condições iniciais e a
+    // integração avança só (t, r, θ, φ) com troca de sinal nos pontos
+    // de retorno.
+    ResultadoRaio tracar_raio_kerr(double alfa, double beta) const {
+        ResultadoRaio resultado;
+        resultado.destino = ResultadoRaio::INFINITO;
+        resultado.passos = 0;
+
+        const MetricaKerr& kerr = *metrica_kerr_;
+
+        double r0 = camera_.r_observador;
+        double theta0 = camera_.theta_observador;
+        double s0 = std::sin(theta0);
+        double c0 = std::cos(theta0);
+
+        // Lançamento: o mesmo mapeamento pixel → (u_θ, u_φ) de
+        // tracar_raio, para que o limite a → 0 reproduza a imagem de
+        // Schwarzschild pixel a pixel; só u_r sai da condição nula na
+        // métrica de Boyer-Lindquist em vez da de Schwarzschild
+        double f = 1.0 - rs_ / r0;
+        double u_t = 1.0 / f;
+        double u_theta = beta / r0;
+        double u_phi = alfa / (r0 * s0);
+
+        // u_r pela condição nula na métrica de Boyer-Lindquist
+        double g_tt = kerr.g_tt(r0, theta0);
+        double g_tp = kerr.g_t_phi(r0, theta0);
+        double g_rr = kerr.g_rr(r0, theta0);
+        double g_hh = kerr.g_theta_theta(r0, theta0);
+        double g_pp = kerr.g_phi_phi(r0, theta0);
+
+        double resto = g_tt * u_t * u_t + 2.0 * g_tp * u_t * u_phi +
+                       g_hh * u_theta * u_theta + g_pp * u_phi * u_phi;
+        double u_r = -std::sqrt(std::max(0.0, -resto / g_rr));
+
+        // Norma do lançamento: com u_t fixado em 1/f e u_r saturando
+        // em zero quando a parte transversal domina, o raio não é
+        // exatamente nulo — μ² = −g(u,u) entra nos potenciais para que
+        // a forma de primeira ordem reproduza exatamente estas
+        // geodésicas (e o limite a → 0 bata com tracar_raio)
+        double mu2 = -(resto + g_rr * u_r * u_r);
+
+        // Constantes de movimento a partir dos momentos covariantes
+        double a = kerr.parametro_spin();
+        double E = -(g_tt * u_t + g_tp * u_phi);
+        double Lz = g_pp * u_phi + g_tp * u_t;
+        double p_theta = g_hh * u_theta;
+        double s0q = (std::abs(s0) < 1e-12) ? 1e-12 : s0;
+        double Q = p_theta * p_theta +
+                   c0 * c0 * (Lz * Lz / (s0q * s0q) +
+                              a * a * (mu2 - E * E));
+
+        // Atalho analítico de captura, como no caminho escalar: o
+        // mergulho quase radial avança ~1 m por unidade de λ (não há
+        // termo centrífugo que o acelere) e estouraria max_passos_.
+        // Em Kerr o parâmetro de impacto crítico depende da direção,
+        // mas nunca fica abaixo de 2M (órbita de fótons prógrada no
+        // limite extremo) — b < 2M garante captura para qualquer spin
+        {
+            double w = std::sqrt(u_theta * u_theta +
+                                 s0 * s0 * u_phi * u_phi);
+            double b = std::sqrt(std::max(0.0, Lz * Lz + Q)) / E;
+            if (b < 2.0 * kerr.massa_geometrica() &&
+                captura_sem_disco(b, u_theta, w)) {
+                resultado.destino = ResultadoRaio::HORIZONTE;
+                resultado.r_impacto = kerr.horizonte_externo();
+                resultado.cor = Pixel(0.0, 0.0, 0.0);
+                return resultado;
+            }
+        }
+
+        double sigma0 = kerr.sigma(r0, theta0);
+        EstadoKerr estado = {0.0, r0, theta0, 0.0,
+                             sigma0 * u_r, p_theta,
+                             E, Lz, Q, mu2};
+
+        IntegradorKerr integrador(kerr, passo_inicial_);
+        double r_horizonte = kerr.horizonte_externo();
+
+        double theta_ant = estado.theta;
+        double r_ant = estado.r;
+        double phi_ant = estado.phi;
+        for (int i = 0; i < max_passos_; i++) {
+            resultado.passos = i;
+
+            if (estado.r < r_horizonte * 1.01) {
+                resultado.destino = ResultadoRaio::HORIZONTE;
+                resultado.r_impacto = estado.r;
+                resultado.cor = Pixel(0.0, 0.0, 0.0);
+                return resultado;
+            }
+
+            // Cruzamento do plano do disco por troca de sinal de θ − π/2,
+            // com o ponto exato interpolado dentro do passo e a mesma
+            // guarda de passo estourado dos demais caminhos
+            double d_ant = theta_ant - M_PI / 2.0;
+            double d_novo = estado.theta - M_PI / 2.0;
+            if (i > 0 && (d_ant > 0.0) != (d_novo > 0.0) &&
+                std::abs(d_novo - d_ant) < SALTO_MAX_CRUZAMENTO) {
+                double frac = d_ant / (d_ant - d_novo);
+                double r_cruz = r_ant + frac * (estado.r - r_ant);
+                double phi_cruz = phi_ant + frac * (estado.phi - phi_ant);
+                if (disco_.no_disco(r_cruz)) {
+                    resultado.destino = ResultadoRaio::DISCO;
+                    resultado.r_impacto = r_cruz;
+                    resultado.phi_impacto = phi_cruz;
+                    resultado.theta_impacto = M_PI / 2.0;
+
+                    // Direção do fóton pela diferença finita do passo
+                    resultado.cos_xi = cos_doppler(
+                        r_cruz, M_PI / 2.0, estado.r - r_ant,
+                        estado.theta - theta_ant, estado.phi - phi_ant);
+                    CorRGB cor_disco = disco_.intensidade_observada(
+                        r_cruz, resultado.cos_xi);
+                    resultado.cor = Pixel(cor_disco.r, cor_disco.g,
+                                          cor_disco.b);
+                    return resultado;
+                }
+            }
+
+            if (estado.r > camera_.r_observador * 2.0) {
+                resultado.destino = ResultadoRaio::INFINITO;
+                resultado.theta_impacto = estado.theta;
+                resultado.phi_impacto = estado.phi;
+                resultado.cor = usar_fundo_
+                    ? cor_fundo(estado.theta, estado.phi)
+                    : Pixel(0.02, 0.02, 0.05);
+                return resultado;
+            }
+
+            // Mesma régua de passo do caminho escalar: grande no campo
+            // distante, fina perto do horizonte (λ aqui tem a mesma
+            // escala — dθ/dλ no lançamento é o próprio u_θ). Perto dos
+            // polos o potencial polar tem o termo rígido Lz²/sin³θ, e o
+            // RK4 de passo fixo registra cruzamentos espúrios do plano
+            // do disco — o passo encolhe proporcional a sin θ ali
+            double s_polo = std::sin(estado.theta);
+            integrador.set_passo(passo_inicial_ *
+                                 std::sqrt(estado.r / rs_) *
+                                 std::max(0.01, std::min(1.0, 8.0 * s_polo * s_polo)));
+
+            theta_ant = estado.theta;
+            r_ant = estado.r;
+            phi_ant = estado.phi;
+            estado = integrador.passo_rk4(estado);
+
+            // Mantém θ em [0, π] (a reflexão inverte p_θ)
             if (estado.theta < 0.0) {
                 estado.theta = -estado.theta;
-                estado.u_theta = -estado.u_theta;
+                estado.p_theta = -estado.p_theta;
             }
             if (estado.theta > M_PI) {
                 estado.theta = 2.0 * M_PI - estado.theta;
-                estado.u_theta = -estado.u_theta;
+                estado.p_theta = -estado.p_theta;
             }
         }
-        
+
         resultado.destino = ResultadoRaio::ERRO;
-        resultado.cor = Pixel(1.0, 0.0, 1.0);  // Magenta = erro
+        resultado.cor = Pixel(1.0, 0.0, 1.0);
         return resultado;
     }
 
     // ============================================================
-    // COR DE FUNDO (GRID CELESTIAL)
+    // CAMINHO RÁPIDO EQUATORIAL
     // ============================================================
-    
-    Pixel cor_fundo(double theta, double phi) const {
-        // Normaliza ângulos
-        phi = std::fmod(phi, 2.0 * M_PI);
-        if (phi < 0) phi += 2.0 * M_PI;
-        
-        // Grid com linhas a cada 15°
-        double espessura = 0.02;
-        double lat = theta - M_PI / 2.0;  // Latitude: -π/2 a π/2
-        double lon = phi;                  // Longitude: 0 a 2π
-        
-        // Linhas de latitude (constante θ)
-        bool linha_lat = false;
-        for (double l = -M_PI / 2.0; l <= M_PI / 2.0; l += M_PI / 12.0) {
-            if (std::abs(lat - l) < espessura) {
-                linha_lat = true;
-                break;
+
+    // Versão reduzida de tracar_raio para raios que vivem no plano
+    // do disco (θ = π/2, u_θ = 0): integra só (r, φ, u_r) usando as
+    // constantes de movimento E e L em vez das 8 componentes.
+    ResultadoRaio tracar_raio_equatorial(double u_r0, double u_phi0) const {
+        ResultadoRaio resultado;
+        resultado.destino = ResultadoRaio::INFINITO;
+        resultado.passos = 0;
+
+        double r0 = camera_.r_observador;
+        double f0 = 1.0 - rs_ / r0;
+
+        EstadoPlanar estado;
+        estado.r = r0;
+        estado.phi = 0.0;
+        estado.u_r = u_r0;
+        estado.E = f0 * (1.0 / f0);        // E = f u_t, com u_t = 1/f
+        estado.L = r0 * r0 * u_phi0;
+
+        IntegradorGeodesico integrador(metrica_, passo_inicial_);
+
+        for (int i = 0; i < max_passos_; i++) {
+            resultado.passos = i;
+
+            if (estado.r < rs_ * tolerancia_horizonte_) {
+                resultado.destino = ResultadoRaio::HORIZONTE;
+                resultado.r_impacto = estado.r;
+                resultado.cor = Pixel(0.0, 0.0, 0.0);
+                return resultado;
+            }
+
+            // O raio já está no plano do disco: basta entrar no anel
+            if (disco_.no_disco(estado.r)) {
+                resultado.destino = ResultadoRaio::DISCO;
+                resultado.r_impacto = estado.r;
+                resultado.phi_impacto = estado.phi;
+                resultado.theta_impacto = M_PI / 2.0;
+
+                resultado.cos_xi = cos_doppler(
+                    estado.r, M_PI / 2.0, estado.u_r, 0.0,
+                    estado.L / (estado.r * estado.r));
+                CorRGB cor_disco = disco_.intensidade_observada(
+                    estado.r, resultado.cos_xi);
+                resultado.cor = Pixel(cor_disco.r, cor_disco.g, cor_disco.b);
+                return resultado;
             }
+
+            if (estado.r > camera_.r_observador * 2.0) {
+                resultado.destino = ResultadoRaio::INFINITO;
+                resultado.theta_impacto = M_PI / 2.0;
+                resultado.phi_impacto = estado.phi;
+                resultado.cor = usar_fundo_
+                    ? cor_fundo(M_PI / 2.0, estado.phi)
+                    : Pixel(0.02, 0.02, 0.05);
+                return resultado;
+            }
+
+            double fator_passo = std::sqrt(estado.r / rs_);
+            integrador.set_passo(passo_inicial_ * fator_passo);
+            estado = integrador.passo_rk4_planar(estado);
         }
-        
-        // Linhas de longitude (constante φ)
-        bool linha_lon = false;
-        for (double l = 0.0; l < 2.0 * M_PI; l += M_PI / 12.0) {
-            double diff = std::abs(lon - l);
-            if (diff < espessura || (2.0 * M_PI - diff) < espessura) {
-                linha_lon = true;
-                break;
+
+        resultado.destino = ResultadoRaio::ERRO;
+        resultado.cor = Pixel(1.0, 0.0, 1.0);
+        return resultado;
+    }
+
+    // ============================================================
+    // TRAÇADO VIA TABELA DE DEFLEXÃO (SPIN = 0)
+    // ============================================================
+
+    // Responde um pixel consultando a trajetória planar pré-computada
+    // para o parâmetro de impacto b do raio, girada para o plano
+    // orbital do próprio raio. Custo O(pontos da polilinha), sem
+    // nenhuma avaliação de Christoffel.
+    ResultadoRaio tracar_raio_tabela(double alfa, double beta) const {
+        ResultadoRaio resultado;
+        resultado.destino = ResultadoRaio::INFINITO;
+        resultado.passos = 0;
+
+        double r0 = camera_.r_observador;
+        double theta0 = camera_.theta_observador;
+        double s0 = std::sin(theta0);
+        double c0 = std::cos(theta0);
+
+        // Velocidade angular transversal e parâmetro de impacto
+        double u_theta = beta / r0;
+        double u_phi = alfa / (r0 * s0);
+        double w = std::sqrt(u_theta * u_theta + s0 * s0 * u_phi * u_phi);
+        double b = r0 * r0 * w;
+
+        // Pixel central: mergulho radial direto no horizonte
+        if (w < 1e-15) {
+            resultado.destino = ResultadoRaio::HORIZONTE;
+            resultado.r_impacto = rs_;
+            resultado.cor = Pixel(0.0, 0.0, 0.0);
+            return resultado;
+        }
+
+        // Fora da cobertura da tabela: integra do jeito tradicional
+        if (!tabela_.construida() || b > tabela_.b_max()) {
+            return tracar_raio(alfa, beta);
+        }
+
+        // Base do plano orbital: n̂ radial (observador em φ = 0) e
+        // m̂ na direção transversal do movimento do fóton
+        double nx = s0, ny = 0.0, nz = c0;
+        double mx = (u_theta * c0) / w;
+        double my = (s0 * u_phi) / w;
+        double mz = (u_theta * -s0) / w;
+
+        // Percorre a polilinha procurando cruzamentos do plano do disco
+        const TrajetoriaPlanar& traj = tabela_.trajetoria(b);
+        resultado.passos = static_cast<int>(traj.r.size());
+
+        double z_ant = traj.r[0] * (std::cos(traj.psi[0]) * nz +
+                                    std::sin(traj.psi[0]) * mz);
+        for (size_t k = 1; k < traj.r.size(); k++) {
+            double cos_psi = std::cos(traj.psi[k]);
+            double sin_psi = std::sin(traj.psi[k]);
+            double z = traj.r[k] * (cos_psi * nz + sin_psi * mz);
+
+            if ((z_ant > 0.0) != (z > 0.0)) {
+                // Cruzou o plano equatorial: interpola o ponto exato
+                double frac = z_ant / (z_ant - z);
+                double r_c = traj.r[k - 1] + frac * (traj.r[k] - traj.r[k - 1]);
+                if (disco_.no_disco(r_c)) {
+                    double psi_c = traj.psi[k - 1] +
+                                   frac * (traj.psi[k] - traj.psi[k - 1]);
+                    double x = r_c * (std::cos(psi_c) * nx + std::sin(psi_c) * mx);
+                    double y = r_c * (std::cos(psi_c) * ny + std::sin(psi_c) * my);
+
+                    resultado.destino = ResultadoRaio::DISCO;
+                    resultado.r_impacto = r_c;
+                    resultado.phi_impacto = std::atan2(y, x);
+                    resultado.theta_impacto = M_PI / 2.0;
+
+                    // Direção do fóton no cruzamento: diferença finita
+                    // da polilinha projetada em φ̂ no ponto de impacto
+                    double cos_c = std::cos(psi_c);
+                    double sin_c = std::sin(psi_c);
+                    double dr_s = traj.r[k] - traj.r[k - 1];
+                    double dpsi = traj.psi[k] - traj.psi[k - 1];
+                    double px = dr_s * (cos_c * nx + sin_c * mx) +
+                                r_c * dpsi * (-sin_c * nx + cos_c * mx);
+                    double py = dr_s * (cos_c * ny + sin_c * my) +
+                                r_c * dpsi * (-sin_c * ny + cos_c * my);
+                    double pz = dr_s * (cos_c * nz + sin_c * mz) +
+                                r_c * dpsi * (-sin_c * nz + cos_c * mz);
+                    double rho = std::sqrt(x * x + y * y);
+                    double norma_p =
+                        std::sqrt(px * px + py * py + pz * pz);
+                    double cos_xi = 0.0;
+                    if (rho > 0.0 && norma_p > 0.0) {
+                        cos_xi = -(px * (-y / rho) + py * (x / rho)) /
+                                 norma_p;
+                    }
+
+                    resultado.cos_xi = cos_xi;
+                    CorRGB cor_disco = disco_.intensidade_observada(
+                        r_c, cos_xi);
+                    resultado.cor = Pixel(cor_disco.r, cor_disco.g, cor_disco.b);
+                    return resultado;
+                }
             }
+            z_ant = z;
         }
-        
-        // Cor das linhas
-        if (linha_lat || linha_lon) {
-            // Gradiente azul-roxo baseado na posição
-            double h = (lon / (2.0 * M_PI));  // Hue 0-1
-            return Pixel(0.2 + 0.3 * h, 0.1, 0.4 + 0.2 * (1.0 - h));
+
+        if (traj.capturado) {
+            resultado.destino = ResultadoRaio::HORIZONTE;
+            resultado.r_impacto = rs_;
+            resultado.cor = Pixel(0.0, 0.0, 0.0);
+            return resultado;
         }
-        
-        // Fundo com estrelas (ruído pseudo-aleatório)
-        double seed = theta * 100.0 + phi * 57.0;
-        double estrela = std::sin(seed * 12345.6789);
-        estrela = (estrela + 1.0) / 2.0;
-        estrela = std::pow(estrela, 100.0);  // Poucas estrelas brilhantes
-        
-        return Pixel(0.01 + 0.5 * estrela, 0.01 + 0.5 * estrela, 0.03 + 0.5 * estrela);
+
+        // Escapou: direção assintótica interpolada entre amostras de b
+        double psi_f = tabela_.psi_final_interpolado(b);
+        double vx = std::cos(psi_f) * nx + std::sin(psi_f) * mx;
+        double vy = std::cos(psi_f) * ny + std::sin(psi_f) * my;
+        double vz = std::cos(psi_f) * nz + std::sin(psi_f) * mz;
+
+        double theta_fuga = std::acos(std::max(-1.0, std::min(1.0, vz)));
+        double phi_fuga = std::atan2(vy, vx);
+
+        resultado.destino = ResultadoRaio::INFINITO;
+        resultado.theta_impacto = theta_fuga;
+        resultado.phi_impacto = phi_fuga;
+        if (usar_fundo_) {
+            resultado.cor = cor_fundo(theta_fuga, phi_fuga);
+        } else {
+            resultado.cor = Pixel(0.02, 0.02, 0.05);
+        }
+        return resultado;
+    }
+
+    // ============================================================
+    // COR DE FUNDO (GRID CELESTIAL)
+    // ============================================================
+    
+    // Uma busca bilinear na textura pré-rasterizada por raio escapado;
+    // o padrão procedural completo só roda se a textura ainda não foi
+    // construída (raios traçados avulsos, antes de renderizar)
+    Pixel cor_fundo(double theta, double phi) const {
+        CorRGB cor = fundo_.vazia()
+            ? FundoCelestial::cor_procedural(theta, phi)
+            : fundo_.amostrar(theta, phi);
+        return Pixel(cor.r, cor.g, cor.b);
     }
 
     // ============================================================
     // RENDERIZAÇÃO COMPLETA
     // ============================================================
     
-    std::vector<std::vector<Pixel>> renderizar() {
+    ImagemBuffer renderizar() {
         int largura = camera_.largura;
         int altura = camera_.altura;
-        
-        std::vector<std::vector<Pixel>> imagem(altura, std::vector<Pixel>(largura));
-        linhas_processadas_ = 0;
-        
-        // Função para processar um bloco de linhas
-        auto processar_bloco = [&](int linha_inicio, int linha_fim) {
-            for (int j = linha_inicio; j < linha_fim; j++) {
-                for (int i = 0; i < largura; i++) {
-                    // Converte pixel para coordenadas de impacto
-                    double alfa = (i - largura / 2.0) / largura * camera_.fov_horizontal * camera_.r_observador;
-                    double beta = (j - altura / 2.0) / altura * camera_.fov_vertical * camera_.r_observador;
-                    
-                    ResultadoRaio resultado = tracar_raio(alfa, beta);
-                    imagem[j][i] = resultado.cor;
+
+        ImagemBuffer imagem(largura, altura);
+        stats_ = EstatisticasRender{};
+
+        // Prepara a tabela de deflexão se o modo estiver ativo:
+        // cobre até o canto do quadro com margem de 5%
+        auto t_setup = std::chrono::steady_clock::now();
+        if (usar_tabela_) {
+            preparar_tabela();
+        }
+        if (usar_fundo_ && fundo_.vazia()) {
+            fundo_.construir();
+        }
+        stats_.tempo_setup = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_setup).count();
+
+        auto t_tracado = std::chrono::steady_clock::now();
+        std::vector<ResultadoRaio::Destino> destinos;
+        if (usar_aa_) {
+            destinos.assign(static_cast<size_t>(largura) * altura,
+                            ResultadoRaio::ERRO);
+        }
+        if (capturar_mapa_) {
+            mapa_.redimensionar(largura, altura);
+        }
+        if (capturar_cache_) {
+            cache_.redimensionar(largura, altura);
+            cache_.chave = chave_geometria();
+        }
+
+        // O modo lote só cobre o caminho RK4 de Schwarzschild; nos
+        // demais, o traçado escalar pixel a pixel continua valendo
+        // (a captura do cache geodésico também fica no escalar)
+        bool lote_ativo = usar_lote_ && !metrica_kerr_ && !usar_tabela_ &&
+                          !usar_rk45_ && !usar_ef_ && !capturar_cache_;
+        if (lote_ativo) {
+            processar_tiles(largura, altura,
+                [&](int i0, int j0, int i1, int j1, int,
+                    std::array<long long, 16>& histograma) {
+                    return tracar_tile_lote(i0, j0, i1, j1, imagem,
+                                            usar_aa_ ? &destinos : nullptr,
+                                            histograma);
+                });
+        } else {
+            processar_grade(largura, altura, [&](int i, int j, int) {
+                // Converte pixel para coordenadas de impacto
+                double alfa = (i - largura / 2.0) / largura * camera_.fov_horizontal * camera_.r_observador;
+                double beta = (j - altura / 2.0) / altura * camera_.fov_vertical * camera_.r_observador;
+
+                ResultadoRaio resultado = usar_tabela_
+                    ? tracar_raio_tabela(alfa, beta)
+                    : tracar_raio(alfa, beta);
+                imagem.em(i, j) = resultado.cor;
+                size_t idx = static_cast<size_t>(j) * largura + i;
+                if (usar_aa_) {
+                    destinos[idx] = resultado.destino;
+                }
+                if (capturar_mapa_) {
+                    mapa_.destino[idx] = static_cast<uint8_t>(resultado.destino);
+                    mapa_.r_impacto[idx] = static_cast<float>(resultado.r_impacto);
+                    mapa_.passos[idx] = resultado.passos;
+                }
+                if (capturar_cache_) {
+                    cache_.destino[idx] =
+                        static_cast<uint8_t>(resultado.destino);
+                    cache_.r_impacto[idx] =
+                        static_cast<float>(resultado.r_impacto);
+                    cache_.cos_xi[idx] =
+                        static_cast<float>(resultado.cos_xi);
+                    cache_.theta_fuga[idx] = resultado.theta_impacto;
+                    cache_.phi_fuga[idx] = resultado.phi_impacto;
                 }
-                
-                linhas_processadas_++;
+                return resultado.passos;
+            });
+        }
+
+        if (usar_aa_) {
+            refinar_bordas(imagem, destinos);
+        }
+        stats_.tempo_tracado = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_tracado).count();
+        stats_.avaliacoes_derivadas =
+            stats_.total_passos * (usar_rk45_ ? 7 : 4);
+
+        return imagem;
+    }
+
+    // Re-shading a partir do cache geodésico: nenhum raio é integrado,
+    // cada pixel vira uma busca no disco ou no fundo com o desfecho
+    // gravado. É o caminho das varreduras de parâmetros do disco —
+    // milissegundos por quadro em vez do traçado inteiro.
+    ImagemBuffer renderizar_reshade() {
+        int largura = camera_.largura;
+        int altura = camera_.altura;
+
+        ImagemBuffer imagem(largura, altura);
+        stats_ = EstatisticasRender{};
+
+        auto t_setup = std::chrono::steady_clock::now();
+        if (usar_fundo_ && fundo_.vazia()) {
+            fundo_.construir();
+        }
+        stats_.tempo_setup = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_setup).count();
+
+        auto t_tracado = std::chrono::steady_clock::now();
+        size_t n = static_cast<size_t>(largura) * altura;
+        for (size_t idx = 0; idx < n; idx++) {
+            switch (static_cast<ResultadoRaio::Destino>(
+                cache_.destino[idx])) {
+                case ResultadoRaio::HORIZONTE:
+                    imagem.dados()[idx] = Pixel(0.0, 0.0, 0.0);
+                    break;
+                case ResultadoRaio::DISCO: {
+                    CorRGB cor = disco_.intensidade_observada(
+                        cache_.r_impacto[idx], cache_.cos_xi[idx]);
+                    imagem.dados()[idx] = Pixel(cor.r, cor.g, cor.b);
+                    break;
+                }
+                case ResultadoRaio::INFINITO:
+                    imagem.dados()[idx] = usar_fundo_
+                        ? cor_fundo(cache_.theta_fuga[idx],
+                                    cache_.phi_fuga[idx])
+                        : Pixel(0.02, 0.02, 0.05);
+                    break;
+                case ResultadoRaio::ERRO:
+                    imagem.dados()[idx] = Pixel(1.0, 0.0, 1.0);
+                    break;
             }
-        };
-        
-        // Divide trabalho entre threads
-        std::vector<std::thread> threads;
-        int linhas_por_thread = altura / num_threads_;
-        
-        for (int t = 0; t < num_threads_; t++) {
-            int inicio = t * linhas_por_thread;
-            int fim = (t == num_threads_ - 1) ? altura : (t + 1) * linhas_por_thread;
-            threads.emplace_back(processar_bloco, inicio, fim);
         }
-        
-        // Aguarda todas as threads
-        for (auto& th : threads) {
-            th.join();
+        stats_.pixels = largura * altura;
+        stats_.tempo_tracado = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_tracado).count();
+
+        return imagem;
+    }
+
+    // Renderiza um retângulo [i0, i1) x [j0, j1) do quadro em `saida`
+    // (row-major local, i1 - i0 colunas), numa única thread. É a
+    // unidade de trabalho do modo distribuído: cada rank MPI traça um
+    // tile por vez, então o paralelismo intra-nó vem de vários ranks
+    // por nó e não do pool de threads.
+    void renderizar_tile(int i0, int j0, int i1, int j1, Pixel* saida) {
+        int largura = camera_.largura;
+        int altura = camera_.altura;
+
+        if (usar_tabela_) {
+            preparar_tabela();
         }
-        
+        if (usar_fundo_ && fundo_.vazia()) {
+            fundo_.construir();
+        }
+
+        for (int j = j0; j < j1; j++) {
+            for (int i = i0; i < i1; i++) {
+                double alfa = (i - largura / 2.0) / largura * camera_.fov_horizontal * camera_.r_observador;
+                double beta = (j - altura / 2.0) / altura * camera_.fov_vertical * camera_.r_observador;
+
+                ResultadoRaio resultado = usar_tabela_
+                    ? tracar_raio_tabela(alfa, beta)
+                    : tracar_raio(alfa, beta);
+                saida[(j - j0) * (i1 - i0) + (i - i0)] = resultado.cor;
+            }
+        }
+    }
+
+    // Estatísticas da última renderização (tempo_codificacao é
+    // preenchido por quem grava a imagem)
+    EstatisticasRender& estatisticas() { return stats_; }
+    const EstatisticasRender& estatisticas() const { return stats_; }
+
+    // ============================================================
+    // RENDERIZAÇÃO PROGRESSIVA
+    // ============================================================
+
+    // Passe grosseiro em 1/fator da resolução seguido do passe
+    // completo. A classificação do passe grosseiro guia o refinamento:
+    // regiões cuja vizinhança grosseira é toda HORIZONTE (a sombra,
+    // tipicamente 20-30% dos pixels) são pintadas de preto sem traçar
+    // um único raio. Se `previa` for dada, recebe a imagem grosseira
+    // para exibição/salvamento intermediário.
+    ImagemBuffer renderizar_progressivo(int fator_inicial = 8,
+                                        ImagemBuffer* previa = nullptr) {
+        int largura = camera_.largura;
+        int altura = camera_.altura;
+        int lc = std::max(2, largura / fator_inicial);
+        int ac = std::max(2, altura / fator_inicial);
+
+        if (usar_tabela_) {
+            preparar_tabela();
+        }
+        if (usar_fundo_ && fundo_.vazia()) {
+            fundo_.construir();
+        }
+
+        // Passe 1: grade grosseira com classificação por destino
+        ImagemBuffer grossa(lc, ac);
+        std::vector<ResultadoRaio::Destino> destinos(
+            static_cast<size_t>(lc) * ac, ResultadoRaio::ERRO);
+
+        processar_grade(lc, ac, [&](int i, int j, int) {
+            double alfa = (i - lc / 2.0) / lc * camera_.fov_horizontal * camera_.r_observador;
+            double beta = (j - ac / 2.0) / ac * camera_.fov_vertical * camera_.r_observador;
+
+            ResultadoRaio resultado = usar_tabela_
+                ? tracar_raio_tabela(alfa, beta)
+                : tracar_raio(alfa, beta);
+            grossa.em(i, j) = resultado.cor;
+            destinos[static_cast<size_t>(j) * lc + i] = resultado.destino;
+            return resultado.passos;
+        });
+
+        if (previa) {
+            *previa = grossa;
+        }
+
+        // Pixel fino pode ser pulado se toda a vizinhança 3x3 da
+        // célula grosseira correspondente caiu no horizonte
+        auto interior_sombra = [&](int i, int j) {
+            int ic = std::min(i * lc / largura, lc - 1);
+            int jc = std::min(j * ac / altura, ac - 1);
+            for (int dj = -1; dj <= 1; dj++) {
+                for (int di = -1; di <= 1; di++) {
+                    int ii = std::max(0, std::min(lc - 1, ic + di));
+                    int jj = std::max(0, std::min(ac - 1, jc + dj));
+                    if (destinos[static_cast<size_t>(jj) * lc + ii] !=
+                        ResultadoRaio::HORIZONTE) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        // Passe 2: resolução completa com o atalho da sombra
+        ImagemBuffer imagem(largura, altura);
+        processar_grade(largura, altura, [&](int i, int j, int) {
+            if (interior_sombra(i, j)) {
+                imagem.em(i, j) = Pixel(0.0, 0.0, 0.0);
+                return 0;
+            }
+
+            double alfa = (i - largura / 2.0) / largura * camera_.fov_horizontal * camera_.r_observador;
+            double beta = (j - altura / 2.0) / altura * camera_.fov_vertical * camera_.r_observador;
+
+            ResultadoRaio resultado = usar_tabela_
+                ? tracar_raio_tabela(alfa, beta)
+                : tracar_raio(alfa, beta);
+            imagem.em(i, j) = resultado.cor;
+            return resultado.passos;
+        });
+
         return imagem;
     }
-    
-    // Progresso da renderização (0.0 - 1.0)
+
+    // ============================================================
+    // RENDERIZAÇÃO EM STREAMING (BANDAS COM CHECKPOINT)
+    // ============================================================
+
+    // Renderiza direto num PPM pré-dimensionado, em bandas horizontais,
+    // gravando cada banda terminada por escrita posicional e anotando
+    // um checkpoint de retomada. A memória fica O(banda) em vez de
+    // O(quadro) — viável para masters 16K — e um job preemptado
+    // recomeça na primeira banda inacabada em vez de perder o quadro.
+    bool renderizar_streaming(const std::string& caminho,
+                              int altura_banda = 64) {
+        int largura = camera_.largura;
+        int altura = camera_.altura;
+        altura_banda = std::max(1, altura_banda);
+        int num_bandas = (altura + altura_banda - 1) / altura_banda;
+
+        stats_ = EstatisticasRender{};
+        auto t_setup = std::chrono::steady_clock::now();
+        if (usar_tabela_) {
+            preparar_tabela();
+        }
+        if (usar_fundo_ && fundo_.vazia()) {
+            fundo_.construir();
+        }
+        stats_.tempo_setup = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_setup).count();
+
+        char cabecalho[64];
+        int tam_cabecalho = std::snprintf(cabecalho, sizeof(cabecalho),
+                                          "P6\n%d %d\n255\n",
+                                          largura, altura);
+        long long tam_total = tam_cabecalho +
+            3LL * largura * altura;
+
+        // Retomada: o checkpoint guarda as dimensões, a chave da cena
+        // (geometria + shading) e quantas bandas já foram gravadas; só
+        // vale se tudo bate e o arquivo parcial ainda existe com o
+        // tamanho esperado — senão bandas velhas de outra câmera ou
+        // outro disco seriam costuradas no quadro sem aviso
+        std::string caminho_ckpt = caminho + ".checkpoint";
+        uint64_t chave = chave_cena();
+        int banda_inicial = 0;
+        {
+            std::ifstream ckpt(caminho_ckpt);
+            int w, h, hb, feitas;
+            uint64_t chave_lida;
+            if (ckpt >> w >> h >> hb >> chave_lida >> feitas &&
+                w == largura && h == altura && hb == altura_banda &&
+                chave_lida == chave) {
+                std::ifstream parcial(caminho,
+                                      std::ios::binary | std::ios::ate);
+                if (parcial.is_open() &&
+                    parcial.tellg() == std::streampos(tam_total)) {
+                    banda_inicial =
+                        std::max(0, std::min(num_bandas, feitas));
+                }
+            }
+        }
+
+        if (banda_inicial == 0) {
+            // Pré-dimensiona o arquivo: cabeçalho + corpo zerado
+            std::ofstream novo(caminho,
+                               std::ios::binary | std::ios::trunc);
+            if (!novo.is_open()) return false;
+            novo.write(cabecalho, tam_cabecalho);
+            novo.seekp(tam_total - 1);
+            novo.put('\0');
+            if (!novo.good()) return false;
+        }
+
+        std::fstream arquivo(caminho, std::ios::in | std::ios::out |
+                                      std::ios::binary);
+        if (!arquivo.is_open()) return false;
+
+        auto t_tracado = std::chrono::steady_clock::now();
+        ImagemBuffer banda;
+        for (int k = banda_inicial; k < num_bandas; k++) {
+            int j0 = k * altura_banda;
+            int linhas = std::min(altura_banda, altura - j0);
+            if (banda.altura() != linhas) {
+                banda = ImagemBuffer(largura, linhas);
+            }
+
+            processar_grade(largura, linhas, [&](int i, int jl, int) {
+                int j = j0 + jl;  // Linha global do quadro
+                double alfa = (i - largura / 2.0) / largura * camera_.fov_horizontal * camera_.r_observador;
+                double beta = (j - altura / 2.0) / altura * camera_.fov_vertical * camera_.r_observador;
+
+                ResultadoRaio resultado = usar_tabela_
+                    ? tracar_raio_tabela(alfa, beta)
+                    : tracar_raio(alfa, beta);
+                banda.em(i, jl) = resultado.cor;
+                return resultado.passos;
+            });
+
+            // Escrita posicional da banda terminada
+            std::vector<uint8_t> bytes = banda.para_bytes();
+            arquivo.seekp(tam_cabecalho + 3LL * largura * j0);
+            arquivo.write(reinterpret_cast<const char*>(bytes.data()),
+                          static_cast<std::streamsize>(bytes.size()));
+            arquivo.flush();
+            if (!arquivo.good()) return false;
+
+            // Checkpoint só depois da banda estar no arquivo
+            std::ofstream ckpt(caminho_ckpt, std::ios::trunc);
+            ckpt << largura << " " << altura << " " << altura_banda
+                 << " " << chave << " " << (k + 1) << "\n";
+        }
+        stats_.tempo_tracado = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_tracado).count();
+        stats_.avaliacoes_derivadas =
+            stats_.total_passos * (usar_rk45_ ? 7 : 4);
+
+        arquivo.close();
+        std::remove(caminho_ckpt.c_str());
+        return true;
+    }
+
+    // Progresso da renderização (0.0 - 1.0), agregado só na leitura
     double progresso() const {
-        return static_cast<double>(linhas_processadas_) / camera_.altura;
+        long long feitos = 0;
+        for (int t = 0; t < num_contadores_; t++) {
+            feitos += progresso_threads_[t].tiles.load(
+                std::memory_order_relaxed);
+        }
+        return static_cast<double>(feitos) / total_tiles_;
+    }
+
+    // Passos de integração executados por cada thread na última
+    // renderização (para verificar o balanceamento de carga)
+    const std::vector<long long>& passos_por_thread() const {
+        return passos_por_thread_;
     }
 
     // ============================================================
     // EXPORTAÇÃO DE IMAGEM
     // ============================================================
     
-    // Salva como PPM (formato simples)
-    bool salvar_ppm(const std::vector<std::vector<Pixel>>& imagem, 
+    // Salva como PPM (formato simples): converte o framebuffer para
+    // bytes de uma vez e grava o corpo num único write()
+    bool salvar_ppm(const ImagemBuffer& imagem,
                     const std::string& caminho) const {
         std::ofstream arquivo(caminho, std::ios::binary);
         if (!arquivo.is_open()) return false;
-        
-        int altura = imagem.size();
-        int largura = imagem[0].size();
-        
-        arquivo << "P6\n" << largura << " " << altura << "\n255\n";
-        
-        for (int j = 0; j < altura; j++) {
-            for (int i = 0; i < largura; i++) {
-                Pixel p = imagem[j][i];
-                p.clamp();
-                arquivo << p.r_byte() << p.g_byte() << p.b_byte();
+
+        arquivo << "P6\n" << imagem.largura() << " "
+                << imagem.altura() << "\n255\n";
+
+        std::vector<uint8_t> bytes = imagem.para_bytes();
+        arquivo.write(reinterpret_cast<const char*>(bytes.data()),
+                      static_cast<std::streamsize>(bytes.size()));
+
+        arquivo.close();
+        return arquivo.good();
+    }
+
+    // Salva como PNG (filtragem e deflate paralelos, via zlib)
+    bool salvar_png(const ImagemBuffer& imagem,
+                    const std::string& caminho) const {
+        std::vector<uint8_t> bytes = imagem.para_bytes();
+        return BuracoNegro::salvar_png(bytes.data(), imagem.largura(),
+                                       imagem.altura(), caminho,
+                                       num_threads_);
+    }
+
+    // Exportação binária colunar para os pipelines de análise, no
+    // lugar do CSV textual (uma ordem de grandeza menor e mapeável
+    // com numpy.memmap). Layout little-endian:
+    //   magica "BNCOL001" | uint32 largura, altura, flags, reservado
+    //   planos row-major na ordem dos bits de flags:
+    //     bit 0: r, g, b (3 planos float32)
+    //     bit 1: destino (uint8)   — ResultadoRaio::Destino
+    //     bit 2: r_impacto (float32)
+    //     bit 3: passos (int32)
+    // Os planos de metadados saem quando a captura (set_captura_mapa)
+    // estava ativa na renderização desta imagem.
+    bool salvar_bin(const ImagemBuffer& imagem,
+                    const std::string& caminho) const {
+        std::ofstream arquivo(caminho, std::ios::binary);
+        if (!arquivo.is_open()) return false;
+
+        int largura = imagem.largura();
+        int altura = imagem.altura();
+        size_t n = static_cast<size_t>(largura) * altura;
+        bool com_mapa = !mapa_.vazio() &&
+                        mapa_.largura == largura && mapa_.altura == altura;
+
+        uint32_t cabecalho[4] = {
+            static_cast<uint32_t>(largura),
+            static_cast<uint32_t>(altura),
+            com_mapa ? 0xFu : 0x1u,
+            0
+        };
+        arquivo.write("BNCOL001", 8);
+        arquivo.write(reinterpret_cast<const char*>(cabecalho),
+                      sizeof(cabecalho));
+
+        // Planos r/g/b em float32, convertidos de uma vez
+        std::vector<float> plano(n);
+        const Pixel* pixels = imagem.dados();
+        for (int canal = 0; canal < 3; canal++) {
+            for (size_t k = 0; k < n; k++) {
+                const Pixel& p = pixels[k];
+                plano[k] = static_cast<float>(
+                    canal == 0 ? p.r : (canal == 1 ? p.g : p.b));
             }
+            arquivo.write(reinterpret_cast<const char*>(plano.data()),
+                          static_cast<std::streamsize>(n * sizeof(float)));
         }
-        
+
+        if (com_mapa) {
+            arquivo.write(reinterpret_cast<const char*>(mapa_.destino.data()),
+                          static_cast<std::streamsize>(n));
+            arquivo.write(reinterpret_cast<const char*>(mapa_.r_impacto.data()),
+                          static_cast<std::streamsize>(n * sizeof(float)));
+            arquivo.write(reinterpret_cast<const char*>(mapa_.passos.data()),
+                          static_cast<std::streamsize>(n * sizeof(int32_t)));
+        }
+
         arquivo.close();
-        return true;
+        return arquivo.good();
     }
-    
-    // Salva como CSV (para análise)
-    bool salvar_csv(const std::vector<std::vector<Pixel>>& imagem,
+
+    // Salva como CSV (legado; os pipelines usam salvar_bin)
+    bool salvar_csv(const ImagemBuffer& imagem,
                     const std::string& caminho) const {
         std::ofstream arquivo(caminho);
         if (!arquivo.is_open()) return false;
-        
+
         arquivo << "x,y,r,g,b\n";
-        
-        int altura = imagem.size();
-        int largura = imagem[0].size();
-        
-        for (int j = 0; j < altura; j++) {
-            for (int i = 0; i < largura; i++) {
-                const Pixel& p = imagem[j][i];
+
+        for (int j = 0; j < imagem.altura(); j++) {
+            for (int i = 0; i < imagem.largura(); i++) {
+                const Pixel& p = imagem.em(i, j);
                 arquivo << i << "," << j << ","
                        << std::fixed << std::setprecision(4)
                        << p.r << "," << p.g << "," << p.b << "\n";
             }
         }
-        
+
         arquivo.close();
         return true;
     }
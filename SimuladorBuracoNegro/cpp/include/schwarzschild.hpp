@@ -151,38 +151,97 @@ public:
         const Coordenadas& pos,
         const Quadrivelocidade& vel
     ) const {
-        double r = pos.r;
-        double theta = pos.theta;
-        
+        std::array<double, 8> y = {pos.t, pos.r, pos.theta, pos.phi,
+                                   vel.u_t, vel.u_r, vel.u_theta,
+                                   vel.u_phi};
         std::array<double, 8> derivs;
-        
-        // Derivadas das coordenadas (velocidades)
-        derivs[0] = vel.u_t;      // dt/dλ
-        derivs[1] = vel.u_r;      // dr/dλ
-        derivs[2] = vel.u_theta;  // dθ/dλ
-        derivs[3] = vel.u_phi;    // dφ/dλ
-        
-        // Derivadas das velocidades (acelerações)
-        // d²t/dλ²
-        derivs[4] = -2.0 * christoffel_t_tr(r) * vel.u_t * vel.u_r;
-        
-        // d²r/dλ²
-        derivs[5] = -christoffel_r_tt(r) * vel.u_t * vel.u_t
-                   - christoffel_r_rr(r) * vel.u_r * vel.u_r
-                   - christoffel_r_theta_theta(r) * vel.u_theta * vel.u_theta
-                   - christoffel_r_phi_phi(r, theta) * vel.u_phi * vel.u_phi;
-        
-        // d²θ/dλ²
-        derivs[6] = -2.0 * christoffel_theta_r_theta(r) * vel.u_r * vel.u_theta
-                   - christoffel_theta_phi_phi(theta) * vel.u_phi * vel.u_phi;
-        
-        // d²φ/dλ²
-        derivs[7] = -2.0 * christoffel_phi_r_phi(r) * vel.u_r * vel.u_phi
-                   - 2.0 * christoffel_phi_theta_phi(theta) * vel.u_theta * vel.u_phi;
-        
+        derivadas_geodesica(y.data(), derivs.data());
         return derivs;
     }
 
+    // Núcleo fundido das derivadas, operando direto no estado bruto
+    // (t, r, θ, φ, u_t, u_r, u_θ, u_φ). Os Γ não são chamados um a um:
+    // as subexpressões comuns (1/r, r - rs, sinθ, cosθ) são calculadas
+    // uma vez por avaliação, com um único par de transcendentais, e a
+    // guarda do horizonte é içada para fora dos termos individuais.
+    // É o ponto mais quente do traçado — fica no header para ser
+    // inlinado nos estágios do RK4/RK45.
+    void derivadas_geodesica(const double* y, double* d) const {
+        double r = y[1];
+        double theta = y[2];
+        double u_t = y[4], u_r = y[5], u_theta = y[6], u_phi = y[7];
+
+        // Subexpressões compartilhadas pelos oito termos
+        double inv_r = 1.0 / r;
+        double rmrs = r - rs_;
+        double s = std::sin(theta);
+        double c = std::cos(theta);
+
+        // Γ^t_tr, Γ^r_tt e Γ^r_rr divergem no horizonte; a guarda
+        // r <= rs zera os três de uma vez (mesmo comportamento das
+        // funções christoffel_* individuais)
+        double gama_t_tr = 0.0, gama_r_tt = 0.0, gama_r_rr = 0.0;
+        if (r > rs_) {
+            double inv_2r_rmrs = 0.5 * inv_r / rmrs;
+            gama_t_tr = rs_ * inv_2r_rmrs;
+            gama_r_rr = -gama_t_tr;
+            gama_r_tt = 0.5 * rs_ * rmrs * inv_r * inv_r * inv_r;
+        }
+
+        d[0] = u_t;
+        d[1] = u_r;
+        d[2] = u_theta;
+        d[3] = u_phi;
+
+        d[4] = -2.0 * gama_t_tr * u_t * u_r;
+        // Γ^r_θθ = -(r - rs), Γ^r_φφ = -(r - rs)sin²θ
+        d[5] = -gama_r_tt * u_t * u_t
+               - gama_r_rr * u_r * u_r
+               + rmrs * (u_theta * u_theta + s * s * u_phi * u_phi);
+        // Γ^θ_rθ = 1/r, Γ^θ_φφ = -sinθcosθ
+        d[6] = -2.0 * inv_r * u_r * u_theta + s * c * u_phi * u_phi;
+        // Γ^φ_rφ = 1/r, Γ^φ_θφ = cotθ
+        d[7] = -2.0 * u_phi * (inv_r * u_r + (c / s) * u_theta);
+    }
+
+    // ============================================================
+    // CARTA DE EDDINGTON-FINKELSTEIN (ENTRANTE)
+    // ============================================================
+
+    // Derivadas na carta entrante (v, r, θ, φ, u_v, u_r, u_θ, u_φ),
+    // com v = t + r*. A métrica ds² = -(1 - rs/r)dv² + 2 dv dr + r²dΩ²
+    // é regular no horizonte: nenhum Γ diverge em r = rs, então um
+    // raio mergulhante o cruza em λ finito com passos normais, em vez
+    // de espiralar com u_t → ∞ na carta de Schwarzschild. r, θ, φ e
+    // u_r, u_θ, u_φ coincidem com a carta padrão; só u_v = u_t + u_r/f
+    // muda — e v não entra em nenhuma observável do traçado.
+    void derivadas_geodesica_ef(const double* y, double* d) const {
+        double r = y[1];
+        double theta = y[2];
+        double u_v = y[4], u_r = y[5], u_theta = y[6], u_phi = y[7];
+
+        double inv_r = 1.0 / r;
+        double f = 1.0 - rs_ * inv_r;
+        double m_r2 = M_ * inv_r * inv_r;   // Γ^v_vv = M/r²
+        double s = std::sin(theta);
+        double c = std::cos(theta);
+        double ang = u_theta * u_theta + s * s * u_phi * u_phi;
+
+        d[0] = u_v;
+        d[1] = u_r;
+        d[2] = u_theta;
+        d[3] = u_phi;
+
+        // Γ^v_vv = M/r², Γ^v_θθ = -r, Γ^v_φφ = -r sin²θ
+        d[4] = -m_r2 * u_v * u_v + r * ang;
+        // Γ^r_vv = (M/r²)f, Γ^r_vr = -M/r²,
+        // Γ^r_θθ = -rf, Γ^r_φφ = -rf sin²θ
+        d[5] = -m_r2 * f * u_v * u_v + 2.0 * m_r2 * u_v * u_r
+               + r * f * ang;
+        d[6] = -2.0 * inv_r * u_r * u_theta + s * c * u_phi * u_phi;
+        d[7] = -2.0 * u_phi * (inv_r * u_r + (c / s) * u_theta);
+    }
+
     // ============================================================
     // INTEGRAIS DE MOVIMENTO
     // ============================================================
@@ -21,6 +21,10 @@
 #include <chrono>
 #include <filesystem>
 
+#ifdef COM_MPI
+#include <mpi.h>
+#endif
+
 namespace BuracoNegro {
 
 // ============================================================
@@ -43,6 +47,9 @@ enum class ModoSimulacao {
 // ============================================================
 
 struct ConfiguracaoSimulacao {
+    // Modo de execução
+    ModoSimulacao modo = ModoSimulacao::RAY_TRACING;
+
     // Parâmetros do buraco negro
     TipoBuracoNegro tipo = TipoBuracoNegro::SCHWARZSCHILD;
     double massa_solar = 10.0;          // Massas solares
@@ -62,13 +69,75 @@ struct ConfiguracaoSimulacao {
     // Parâmetros de integração
     double passo_integracao = 0.1;
     int max_passos = 10000;
+
+    // Tabela de deflexão 1D (atalho exato apenas para spin = 0)
+    bool usar_tabela_deflexao = false;
+
+    // Integração adaptativa RK45 (Dormand-Prince) com controle de erro
+    bool usar_rk45 = false;
+
+    // Traçado em lotes SoA com ordenação por custo previsto (spin = 0)
+    bool usar_lote = false;
+
+    // Carta de Eddington-Finkelstein entrante (spin = 0, RK4 escalar):
+    // regular no horizonte, corta a cauda de passos dos raios capturados
+    bool usar_ef = false;
+
+    // Precisão mista no modo lote: float32 além de raio_promocao (rs),
+    // double aquém
+    bool precisao_mista = false;
+    double raio_promocao = 20.0;
+
+    // Renderização progressiva (prévia grosseira + refinamento guiado)
+    bool progressivo = false;
+
+    // Anti-aliasing adaptativo (amostras extras só nos pixels de borda)
+    bool antialiasing = false;
+    int amostras_aa = 4;
+
+    // Renderização em streaming: bandas gravadas direto no arquivo,
+    // memória O(banda) e retomada por checkpoint (quadros gigantes)
+    bool streaming = false;
+    int altura_banda = 64;
     
     // Parâmetros de performance
     int num_threads = 4;
+
+    // Fixa cada thread do pool num núcleo (nós NUMA de dois soquetes)
+    bool fixar_threads = false;
     
+    // Mapa de céu equiretangular (PPM P6); vazio usa o grid procedural
+    std::string arquivo_fundo;
+
+    // Formato da imagem gravada: "png" (padrão, comprimido em paralelo)
+    // ou "ppm" (cru, e o único do modo streaming)
+    std::string formato_imagem = "png";
+
+    // Cor do disco por espectro de Planck deslocado (tabela CIE 2D)
+    bool espectral = false;
+
+    // Cache do desfecho geodésico por pixel, endereçado pela chave da
+    // geometria: varreduras que só mudam o disco re-sombreiam em ms
+    bool cache_geodesicas = false;
+
+    // Exportação binária colunar (.bin) com os planos r/g/b float32 e
+    // os metadados por raio (destino, r_impacto, passos) para análise
+    bool exportar_bin = false;
+
     // Saída
     std::string diretorio_saida = "../saida";
     std::string prefixo_arquivo = "buraco_negro";
+
+    // Animação: número de quadros e destino da câmera (valores < 0
+    // mantêm o parâmetro inicial constante ao longo da sequência)
+    int quadros_animacao = 0;
+    double inclinacao_final = -1.0;
+    double distancia_final = -1.0;
+
+    // Modo GEODESICAS: enxame de partículas de teste no disco
+    int num_particulas = 1000;
+    int pontos_trajetoria = 1024;   // Capacidade da arena por partícula
+    int estride_trajetoria = 8;     // Grava 1 ponto a cada k passos
 };
 
 // ============================================================
@@ -100,7 +169,8 @@ public:
         // Cria o ray tracer
         ray_tracer_ = std::make_unique<RayTracer>(
             config_.massa_solar,
-            config_.taxa_eddington
+            config_.taxa_eddington,
+            config_.tipo == TipoBuracoNegro::KERR ? config_.spin : 0.0
         );
         
         // Configura câmera
@@ -114,7 +184,30 @@ public:
         
         ray_tracer_->set_camera(cam);
         ray_tracer_->set_threads(config_.num_threads);
-        
+        ray_tracer_->set_afinidade(config_.fixar_threads);
+
+        // A tabela só é válida sem rotação
+        ray_tracer_->set_tabela_deflexao(
+            config_.usar_tabela_deflexao &&
+            config_.tipo == TipoBuracoNegro::SCHWARZSCHILD);
+
+        ray_tracer_->set_rk45(config_.usar_rk45);
+        ray_tracer_->set_lote(config_.usar_lote);
+        ray_tracer_->set_coordenadas_ef(config_.usar_ef);
+        ray_tracer_->set_precisao_mista(config_.precisao_mista,
+                                        config_.raio_promocao);
+        ray_tracer_->set_antialiasing(config_.antialiasing,
+                                      config_.amostras_aa);
+        ray_tracer_->set_captura_mapa(config_.exportar_bin);
+        ray_tracer_->set_espectral(config_.espectral);
+
+        if (!config_.arquivo_fundo.empty() &&
+            !ray_tracer_->carregar_fundo(config_.arquivo_fundo)) {
+            std::cerr << "Aviso: não foi possível carregar o fundo '"
+                      << config_.arquivo_fundo
+                      << "', usando o grid procedural.\n";
+        }
+
         // Cria diretório de saída se não existe
         std::filesystem::create_directories(config_.diretorio_saida);
     }
@@ -123,6 +216,17 @@ public:
         config_ = config;
         inicializar();
     }
+
+    // Grava a imagem no formato configurado e devolve o caminho final
+    std::string salvar_imagem(const ImagemBuffer& imagem,
+                              const std::string& caminho_base) {
+        if (config_.formato_imagem == "ppm") {
+            std::string caminho = caminho_base + ".ppm";
+            return ray_tracer_->salvar_ppm(imagem, caminho) ? caminho : "";
+        }
+        std::string caminho = caminho_base + ".png";
+        return ray_tracer_->salvar_png(imagem, caminho) ? caminho : "";
+    }
     
     // ============================================================
     // EXECUÇÃO
@@ -147,10 +251,93 @@ public:
         std::cout << "\n[INICIANDO RENDERIZAÇÃO...]\n\n";
         
         auto inicio = std::chrono::high_resolution_clock::now();
-        
+
+        // Modo streaming: as bandas vão direto para o arquivo, sem
+        // framebuffer do quadro inteiro; retomada via checkpoint. O
+        // nome fica sem timestamp de propósito: um job preemptado e
+        // relançado precisa cair no mesmo caminho para reencontrar o
+        // .checkpoint e o PPM parcial
+        if (config_.streaming) {
+            std::string nome_arquivo = gerar_nome_arquivo(false);
+            std::string caminho_ppm = config_.diretorio_saida + "/" +
+                                      nome_arquivo + ".ppm";
+
+            if (!ray_tracer_->renderizar_streaming(caminho_ppm,
+                                                   config_.altura_banda)) {
+                std::cerr << "[ERRO] Falha na renderização em streaming!\n";
+                return false;
+            }
+
+            auto fim = std::chrono::high_resolution_clock::now();
+            tempo_ultima_renderizacao_ =
+                std::chrono::duration<double>(fim - inicio).count();
+
+            std::cout << "\n[RENDERIZAÇÃO COMPLETA] "
+                      << std::fixed << std::setprecision(2)
+                      << tempo_ultima_renderizacao_ << " s\n";
+            std::cout << "[SALVO] " << caminho_ppm << "\n";
+
+            std::string caminho_json = config_.diretorio_saida + "/" +
+                                       nome_arquivo + "_stats.json";
+            if (ray_tracer_->estatisticas().salvar_json(caminho_json)) {
+                std::cout << "[STATS] " << caminho_json << "\n";
+            }
+            return true;
+        }
+
         // Executa ray tracing
-        auto imagem = ray_tracer_->renderizar();
-        
+        ImagemBuffer imagem;
+        bool reaproveitou_cache = false;
+        std::string caminho_cache;
+
+        // Cache geodésico: se um arquivo com a mesma chave de
+        // geometria existe, só o shading roda (o disco e o fundo podem
+        // ter mudado à vontade); senão o traçado captura o desfecho
+        // por pixel e grava o cache para as próximas varreduras
+        if (config_.cache_geodesicas && !config_.progressivo &&
+            !config_.antialiasing) {
+            std::ostringstream nome_cache;
+            nome_cache << "geodesicas_" << std::hex
+                       << ray_tracer_->chave_geometria() << ".bin";
+            caminho_cache = config_.diretorio_saida + "/" +
+                            nome_cache.str();
+
+            if (ray_tracer_->carregar_cache(caminho_cache)) {
+                imagem = ray_tracer_->renderizar_reshade();
+                reaproveitou_cache = true;
+                std::cout << "[CACHE] Geometria reaproveitada de "
+                          << caminho_cache << " (só re-shading)\n";
+            } else {
+                ray_tracer_->set_captura_cache(true);
+            }
+        }
+
+        if (reaproveitou_cache) {
+            // Imagem já pronta pelo re-shading
+        } else if (config_.progressivo) {
+            // Prévia grosseira salva imediatamente; o passe completo
+            // pula o interior da sombra classificado pela prévia
+            ImagemBuffer previa;
+            imagem = ray_tracer_->renderizar_progressivo(8, &previa);
+
+            std::string caminho_previa = salvar_imagem(
+                previa, config_.diretorio_saida + "/" +
+                gerar_nome_arquivo() + "_previa");
+            if (!caminho_previa.empty()) {
+                std::cout << "[PRÉVIA] " << caminho_previa << "\n";
+            }
+        } else {
+            imagem = ray_tracer_->renderizar();
+        }
+
+        if (!reaproveitou_cache && !caminho_cache.empty()) {
+            ray_tracer_->set_captura_cache(false);
+            if (ray_tracer_->salvar_cache(caminho_cache)) {
+                std::cout << "[CACHE] Desfecho geodésico gravado em "
+                          << caminho_cache << "\n";
+            }
+        }
+
         auto fim = std::chrono::high_resolution_clock::now();
         tempo_ultima_renderizacao_ = 
             std::chrono::duration<double>(fim - inicio).count();
@@ -165,18 +352,359 @@ public:
         
         // Salva imagem
         std::string nome_arquivo = gerar_nome_arquivo();
-        std::string caminho_ppm = config_.diretorio_saida + "/" + nome_arquivo + ".ppm";
-        
-        if (ray_tracer_->salvar_ppm(imagem, caminho_ppm)) {
-            std::cout << "[SALVO] " << caminho_ppm << "\n";
+        std::string caminho_base = config_.diretorio_saida + "/" + nome_arquivo;
+
+        auto inicio_encode = std::chrono::high_resolution_clock::now();
+        std::string caminho_imagem = salvar_imagem(imagem, caminho_base);
+        auto fim_encode = std::chrono::high_resolution_clock::now();
+
+        if (!caminho_imagem.empty()) {
+            std::cout << "[SALVO] " << caminho_imagem << "\n";
         } else {
             std::cerr << "[ERRO] Não foi possível salvar a imagem!\n";
             return false;
         }
-        
+
+        // Estatísticas de desempenho em JSON ao lado da imagem
+        EstatisticasRender& stats = ray_tracer_->estatisticas();
+        stats.tempo_codificacao =
+            std::chrono::duration<double>(fim_encode - inicio_encode).count();
+
+        std::string caminho_json = config_.diretorio_saida + "/" +
+                                   nome_arquivo + "_stats.json";
+        if (stats.salvar_json(caminho_json)) {
+            std::cout << "[STATS] " << caminho_json << "\n";
+        }
+
+        if (config_.exportar_bin) {
+            std::string caminho_bin = config_.diretorio_saida + "/" +
+                                      nome_arquivo + ".bin";
+            if (ray_tracer_->salvar_bin(imagem, caminho_bin)) {
+                std::cout << "[BIN] " << caminho_bin << "\n";
+            }
+        }
+
         return true;
     }
-    
+
+#ifdef COM_MPI
+    // ============================================================
+    // RENDERIZAÇÃO DISTRIBUÍDA (MPI)
+    // ============================================================
+
+    // Sharding dinâmico de tiles entre ranks: o rank 0 coordena e
+    // funde os resultados no framebuffer final; os demais pedem um
+    // tile, traçam e devolvem os pixels. Como inicializar() é
+    // totalmente determinístico a partir da ConfiguracaoSimulacao e
+    // todos os ranks parseiam a mesma linha de comando, o protocolo se
+    // resume a ids de tile e blocos de pixels — nada de configuração
+    // na rede. No fim da fila, tiles ainda pendentes são re-emitidos
+    // para ranks ociosos (stragglers não seguram o quadro; resultados
+    // duplicados são descartados pelo coordenador).
+    bool renderizar_distribuido() {
+        constexpr int TILE = 64;
+        constexpr int TAG_RESULTADO = 1;
+        constexpr int TAG_PIXELS = 2;
+        constexpr int TAG_TRABALHO = 3;
+
+        int rank = 0, ranks = 1;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+
+        int largura = config_.largura;
+        int altura = config_.altura;
+        int tiles_x = (largura + TILE - 1) / TILE;
+        int tiles_y = (altura + TILE - 1) / TILE;
+        int total = tiles_x * tiles_y;
+
+        auto retangulo = [&](int tile, int& i0, int& j0,
+                             int& i1, int& j1) {
+            i0 = (tile % tiles_x) * TILE;
+            j0 = (tile / tiles_x) * TILE;
+            i1 = std::min(i0 + TILE, largura);
+            j1 = std::min(j0 + TILE, altura);
+        };
+
+        if (rank != 0) {
+            // Trabalhador: pede, traça, devolve
+            std::vector<Pixel> tile_pixels(TILE * TILE);
+            std::vector<float> envio(3 * TILE * TILE);
+            int tile = -1;
+            MPI_Send(&tile, 1, MPI_INT, 0, TAG_RESULTADO,
+                     MPI_COMM_WORLD);
+            while (true) {
+                MPI_Recv(&tile, 1, MPI_INT, 0, TAG_TRABALHO,
+                         MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                if (tile < 0) break;
+
+                int i0, j0, i1, j1;
+                retangulo(tile, i0, j0, i1, j1);
+                int n = (i1 - i0) * (j1 - j0);
+                ray_tracer_->renderizar_tile(i0, j0, i1, j1,
+                                             tile_pixels.data());
+                for (int k = 0; k < n; k++) {
+                    envio[3 * k]     = static_cast<float>(tile_pixels[k].r);
+                    envio[3 * k + 1] = static_cast<float>(tile_pixels[k].g);
+                    envio[3 * k + 2] = static_cast<float>(tile_pixels[k].b);
+                }
+                MPI_Send(&tile, 1, MPI_INT, 0, TAG_RESULTADO,
+                         MPI_COMM_WORLD);
+                MPI_Send(envio.data(), 3 * n, MPI_FLOAT, 0, TAG_PIXELS,
+                         MPI_COMM_WORLD);
+            }
+            return true;
+        }
+
+        // Coordenador: entrega tiles conforme os ranks ficam livres e
+        // funde os blocos recebidos no quadro final
+        auto inicio = std::chrono::steady_clock::now();
+        ImagemBuffer imagem(largura, altura);
+        std::vector<uint8_t> recebido(total, 0);
+        std::vector<float> bloco(3 * TILE * TILE);
+        int feitos = 0;
+        int proximo = 0;
+        int re_emissao = 0;   // Cursor da redistribuição final
+        int ativos = ranks - 1;
+
+        while (ativos > 0) {
+            MPI_Status status;
+            int tile_devolvido;
+            MPI_Recv(&tile_devolvido, 1, MPI_INT, MPI_ANY_SOURCE,
+                     TAG_RESULTADO, MPI_COMM_WORLD, &status);
+
+            if (tile_devolvido >= 0) {
+                int i0, j0, i1, j1;
+                retangulo(tile_devolvido, i0, j0, i1, j1);
+                int n = (i1 - i0) * (j1 - j0);
+                MPI_Recv(bloco.data(), 3 * n, MPI_FLOAT,
+                         status.MPI_SOURCE, TAG_PIXELS, MPI_COMM_WORLD,
+                         MPI_STATUS_IGNORE);
+
+                if (!recebido[tile_devolvido]) {
+                    recebido[tile_devolvido] = 1;
+                    feitos++;
+                    for (int k = 0; k < n; k++) {
+                        imagem.em(i0 + k % (i1 - i0),
+                                  j0 + k / (i1 - i0)) =
+                            Pixel(bloco[3 * k], bloco[3 * k + 1],
+                                  bloco[3 * k + 2]);
+                    }
+                }
+            }
+
+            // Próximo trabalho: a fila normal e, esgotada ela, os
+            // tiles entregues mas ainda não devolvidos
+            int tile = -1;
+            if (proximo < total) {
+                tile = proximo++;
+            } else if (feitos < total) {
+                while (recebido[re_emissao]) {
+                    re_emissao = (re_emissao + 1) % total;
+                }
+                tile = re_emissao;
+                re_emissao = (re_emissao + 1) % total;
+            } else {
+                ativos--;
+            }
+            MPI_Send(&tile, 1, MPI_INT, status.MPI_SOURCE, TAG_TRABALHO,
+                     MPI_COMM_WORLD);
+        }
+
+        double segundos = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - inicio).count();
+        std::cout << "[MPI] " << total << " tiles em " << ranks - 1
+                  << " trabalhadores, " << std::fixed
+                  << std::setprecision(1) << segundos << " s\n";
+
+        std::string caminho_base = config_.diretorio_saida + "/" +
+                                   gerar_nome_arquivo();
+        std::string caminho = salvar_imagem(imagem, caminho_base);
+        if (caminho.empty()) {
+            std::cerr << "[ERRO] Não foi possível salvar a imagem!\n";
+            return false;
+        }
+        std::cout << "[OK] Imagem salva: " << caminho << "\n";
+        return true;
+    }
+#endif // COM_MPI
+
+    // ============================================================
+    // ANIMAÇÃO EM LOTE
+    // ============================================================
+
+    // Renderiza uma sequência inteira num único processo: o simulador
+    // (métrica, disco, tabelas) é construído uma vez e só a câmera é
+    // interpolada entre quadros. A gravação do quadro k corre numa
+    // thread enquanto o quadro k+1 já está sendo traçado.
+    bool renderizar_animacao() {
+        if (!ray_tracer_) {
+            std::cerr << "Erro: Ray tracer não inicializado!" << std::endl;
+            return false;
+        }
+
+        int n = config_.quadros_animacao;
+        double inc_final = config_.inclinacao_final >= 0.0
+            ? config_.inclinacao_final : config_.angulo_inclinacao;
+        double dist_final = config_.distancia_final >= 0.0
+            ? config_.distancia_final : config_.distancia_observador;
+
+        std::cout << "\n[ANIMAÇÃO] " << n << " quadros, inclinação "
+                  << config_.angulo_inclinacao << "° → " << inc_final
+                  << "°, distância " << config_.distancia_observador
+                  << " rs → " << dist_final << " rs\n\n";
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        std::thread codificador;
+
+        for (int q = 0; q < n; q++) {
+            double frac = (n > 1) ? static_cast<double>(q) / (n - 1) : 0.0;
+            double inc = config_.angulo_inclinacao +
+                         frac * (inc_final - config_.angulo_inclinacao);
+            double dist = config_.distancia_observador +
+                          frac * (dist_final - config_.distancia_observador);
+
+            Camera cam;
+            cam.largura = config_.largura;
+            cam.altura = config_.altura;
+            cam.r_observador = dist;
+            cam.theta_observador = (90.0 - inc) * M_PI / 180.0;
+            cam.fov_horizontal = config_.fov * M_PI / 180.0;
+            cam.fov_vertical = config_.fov * M_PI / 180.0 *
+                               config_.altura / config_.largura;
+            ray_tracer_->set_camera(cam);
+
+            ImagemBuffer imagem = ray_tracer_->renderizar();
+
+            // Espera a gravação do quadro anterior antes de despachar
+            if (codificador.joinable()) {
+                codificador.join();
+            }
+
+            std::ostringstream nome;
+            nome << config_.diretorio_saida << "/" << config_.prefixo_arquivo
+                 << "_anim" << std::setw(4) << std::setfill('0') << q;
+            std::string caminho_base = nome.str();
+
+            std::string caminho = caminho_base +
+                (config_.formato_imagem == "ppm" ? ".ppm" : ".png");
+            codificador = std::thread(
+                [this, img = std::move(imagem), caminho_base]() {
+                    salvar_imagem(img, caminho_base);
+                });
+
+            std::cout << "  quadro " << (q + 1) << "/" << n
+                      << " → " << caminho << "\n";
+        }
+
+        if (codificador.joinable()) {
+            codificador.join();
+        }
+
+        auto fim = std::chrono::high_resolution_clock::now();
+        tempo_ultima_renderizacao_ =
+            std::chrono::duration<double>(fim - inicio).count();
+
+        std::cout << "\n[ANIMAÇÃO COMPLETA] " << std::fixed
+                  << std::setprecision(2) << tempo_ultima_renderizacao_
+                  << " s (" << tempo_ultima_renderizacao_ / n
+                  << " s/quadro)\n";
+        return true;
+    }
+
+    // ============================================================
+    // MODO GEODÉSICAS (ENXAME DE PARTÍCULAS)
+    // ============================================================
+
+    // Integra um enxame de partículas de teste em órbitas quase
+    // circulares do disco (perturbação radial determinística por hash)
+    // usando o motor de lote com arena pré-alocada, e exporta as
+    // trajetórias num arquivo binário colunar BNTRJ001:
+    //   magica | uint32 num_particulas, max_pontos, estride, reservado
+    //   int32 num_pontos[num_particulas]
+    //   pontos da partícula p em [p*max_pontos, ...), 8 doubles cada
+    //   (lambda, t, r, theta, phi, x, y, z)
+    bool simular_geodesicas() {
+        MetricaSchwarzschild metrica(config_.massa_solar);
+        double rs = metrica.raio_schwarzschild();
+        double M = metrica.massa_geometrica();
+
+        int n = config_.num_particulas;
+        std::cout << "\n[GEODÉSICAS] " << n << " partículas, arena de "
+                  << config_.pontos_trajetoria << " pontos/partícula, 1 ponto a cada "
+                  << config_.estride_trajetoria << " passos\n";
+
+        // Condições iniciais: órbitas circulares entre a ISCO e 10 rs,
+        // com perturbação radial de até 5% da velocidade orbital
+        std::vector<EstadoGeodesica> iniciais;
+        iniciais.reserve(n);
+        for (int p = 0; p < n; p++) {
+            double frac = (n > 1) ? static_cast<double>(p) / (n - 1) : 0.0;
+            double r = metrica.raio_isco() + frac * (10.0 * rs - metrica.raio_isco());
+
+            // Órbita circular: Ω = √(M/r³), u^t = 1/√(1 - 3M/r)
+            double omega = std::sqrt(M / (r * r * r));
+            double u_t = 1.0 / std::sqrt(1.0 - 3.0 * M / r);
+            double u_phi = omega * u_t;
+
+            // Perturbação determinística (mesmo hash senoidal do resto
+            // do código) para espalhar as excentricidades
+            double ruido = std::sin(p * 127.1 + 311.7) * 43758.5453;
+            ruido -= std::floor(ruido);
+            double u_r = (ruido - 0.5) * 0.1 * r * omega * u_t;
+
+            iniciais.push_back({0.0, r, M_PI / 2.0, 2.0 * M_PI * frac,
+                                u_t, u_r, 0.0, u_phi});
+        }
+
+        // Passo na escala do raio; a arena limita o total integrado
+        IntegradorGeodesico integrador(metrica, 0.05 * rs);
+        double lambda_max = 0.05 * rs * config_.estride_trajetoria *
+                            static_cast<double>(config_.pontos_trajetoria);
+
+        ArenaTrajetorias arena;
+        arena.redimensionar(n, config_.pontos_trajetoria);
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        integrador.integrar_lote(iniciais, lambda_max, arena,
+                                 config_.estride_trajetoria,
+                                 config_.num_threads);
+        auto fim = std::chrono::high_resolution_clock::now();
+        double tempo = std::chrono::duration<double>(fim - inicio).count();
+
+        long long total_pontos = 0;
+        for (int p = 0; p < n; p++) total_pontos += arena.num_pontos[p];
+
+        std::cout << "  " << total_pontos << " pontos em " << std::fixed
+                  << std::setprecision(2) << tempo << " s ("
+                  << std::setprecision(0) << total_pontos / tempo
+                  << " pontos/s)\n";
+
+        // Exporta a arena inteira em gravações em bloco
+        std::string caminho = config_.diretorio_saida + "/" +
+            config_.prefixo_arquivo + "_trajetorias.bin";
+        std::ofstream arquivo(caminho, std::ios::binary);
+        if (!arquivo.is_open()) {
+            std::cerr << "[ERRO] Não foi possível gravar " << caminho << "\n";
+            return false;
+        }
+        uint32_t cabecalho[4] = {
+            static_cast<uint32_t>(n),
+            static_cast<uint32_t>(arena.max_pontos),
+            static_cast<uint32_t>(config_.estride_trajetoria), 0};
+        arquivo.write("BNTRJ001", 8);
+        arquivo.write(reinterpret_cast<const char*>(cabecalho),
+                      sizeof(cabecalho));
+        arquivo.write(reinterpret_cast<const char*>(arena.num_pontos.data()),
+                      static_cast<std::streamsize>(n * sizeof(int32_t)));
+        arquivo.write(reinterpret_cast<const char*>(arena.pontos.data()),
+                      static_cast<std::streamsize>(
+                          arena.pontos.size() * sizeof(PontoTrajetoria)));
+        arquivo.close();
+
+        std::cout << "[SALVO] " << caminho << "\n";
+        return arquivo.good();
+    }
+
     // ============================================================
     // ANÁLISE FÍSICA
     // ============================================================
@@ -271,18 +799,22 @@ public:
     // UTILITÁRIOS
     // ============================================================
     
-    std::string gerar_nome_arquivo() const {
+    // O timestamp evita sobrescrever renders anteriores, mas pode ser
+    // omitido quando o nome precisa ser reprodutível entre execuções
+    // (o modo streaming só reencontra o checkpoint com o mesmo caminho)
+    std::string gerar_nome_arquivo(bool com_timestamp = true) const {
         std::ostringstream ss;
         ss << config_.prefixo_arquivo;
         ss << "_M" << static_cast<int>(config_.massa_solar);
         ss << "_inc" << static_cast<int>(config_.angulo_inclinacao);
         ss << "_" << config_.largura << "x" << config_.altura;
-        
-        // Adiciona timestamp
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        ss << "_" << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
-        
+
+        if (com_timestamp) {
+            auto now = std::chrono::system_clock::now();
+            auto time_t = std::chrono::system_clock::to_time_t(now);
+            ss << "_" << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
+        }
+
         return ss.str();
     }
     
@@ -0,0 +1,181 @@
+// ============================================================
+// SimuladorBuracoNegro - Tabela de Deflexão por Parâmetro de Impacto
+// Autor: Luiz Tiago Wilcke
+//
+// Para Schwarzschild (spin = 0) o destino de uma geodésica nula
+// é inteiramente determinado pelo parâmetro de impacto b: a
+// trajetória vive num plano e só depende de (b, r0). Esta tabela
+// integra uma família 1D de trajetórias planares uma única vez e
+// responde cada pixel com uma consulta, em vez de re-integrar a
+// EDO de 8 dimensões para cada um dos ~500 mil raios do quadro.
+// ============================================================
+
+#ifndef TABELA_DEFLEXAO_HPP
+#define TABELA_DEFLEXAO_HPP
+
+#include "schwarzschild.hpp"
+#include "integrador.hpp"
+#include <vector>
+#include <thread>
+#include <cmath>
+
+namespace BuracoNegro {
+
+// ============================================================
+// TRAJETÓRIA PLANAR AMOSTRADA
+// ============================================================
+
+// Polilinha (ψ, r) da geodésica no seu próprio plano orbital,
+// do observador (ψ = 0) até a captura ou a fuga. Armazenada em
+// float: a consulta só interpola linearmente entre pontos.
+struct TrajetoriaPlanar {
+    bool capturado = false;  // Terminou no horizonte
+    double psi_final = 0.0;  // Ângulo total varrido até a fuga
+    std::vector<float> psi;  // Ângulo varrido no plano orbital
+    std::vector<float> r;    // Raio correspondente
+};
+
+// ============================================================
+// CLASSE TABELA DE DEFLEXÃO
+// ============================================================
+
+class TabelaDeflexao {
+private:
+    double rs_ = 0.0;        // Raio de Schwarzschild da configuração
+    double r0_ = 0.0;        // Raio do observador
+    double b_max_ = 0.0;     // Maior parâmetro de impacto coberto
+    int num_amostras_ = 0;
+    std::vector<TrajetoriaPlanar> trajetorias_;
+    bool construida_ = false;
+
+    // Integra uma trajetória planar (θ = π/2, u_θ = 0) para o
+    // parâmetro de impacto b, guardando um ponto a cada passo.
+    TrajetoriaPlanar integrar_planar(const MetricaSchwarzschild& metrica,
+                                     double b, double passo_inicial,
+                                     int max_passos) const {
+        TrajetoriaPlanar traj;
+
+        double f0 = 1.0 - rs_ / r0_;
+        double u_t = 1.0 / f0;             // E = 1
+        double u_phi = b / (r0_ * r0_);    // L = b (para E = 1)
+
+        // Condição nula: u_r² = f(f u_t² - r² u_φ²)
+        double u_r_sq = f0 * (f0 * u_t * u_t - r0_ * r0_ * u_phi * u_phi);
+        double u_r = -std::sqrt(std::max(0.0, u_r_sq));
+
+        EstadoGeodesica estado = {0.0, r0_, M_PI / 2.0, 0.0,
+                                  u_t, u_r, 0.0, u_phi};
+
+        IntegradorGeodesico integrador(metrica, passo_inicial);
+        double tol_horizonte = rs_ * 1.001;
+
+        traj.psi.push_back(0.0f);
+        traj.r.push_back(static_cast<float>(r0_));
+
+        for (int i = 0; i < max_passos; i++) {
+            if (estado.r < tol_horizonte) {
+                traj.capturado = true;
+                break;
+            }
+            if (estado.r > r0_ * 2.0) {
+                break;
+            }
+
+            double fator_passo = std::sqrt(estado.r / rs_);
+            integrador.set_passo(passo_inicial * fator_passo);
+            estado = integrador.passo_rk4(estado);
+
+            traj.psi.push_back(static_cast<float>(estado.phi));
+            traj.r.push_back(static_cast<float>(estado.r));
+        }
+
+        traj.psi_final = estado.phi;
+        return traj;
+    }
+
+public:
+    TabelaDeflexao() = default;
+
+    // Mapeamento quadrático índice → b: concentra as amostras em b
+    // pequeno, onde fica toda a estrutura interessante (b_crit ≈ 2.6 rs),
+    // já que b_max cobre o canto do quadro e é ordens de grandeza maior.
+    double b_da_amostra(int k) const {
+        double frac = static_cast<double>(k) / (num_amostras_ - 1);
+        return b_max_ * frac * frac;
+    }
+
+    double indice_do_b(double b) const {
+        return std::sqrt(b / b_max_) * (num_amostras_ - 1);
+    }
+
+    // Constrói a família de trajetórias em [0, b_max].
+    // Paralelizado por blocos: a construção custa o equivalente a uma
+    // única coluna de pixels do quadro.
+    void construir(const MetricaSchwarzschild& metrica,
+                   double r0, double b_max,
+                   int num_amostras = 4096,
+                   double passo_inicial = 0.1,
+                   int max_passos = 10000,
+                   int num_threads = 4) {
+        rs_ = metrica.raio_schwarzschild();
+        r0_ = r0;
+        b_max_ = b_max;
+        num_amostras_ = num_amostras;
+        trajetorias_.assign(num_amostras, {});
+
+        auto construir_bloco = [&](int inicio, int fim) {
+            for (int k = inicio; k < fim; k++) {
+                trajetorias_[k] = integrar_planar(metrica, b_da_amostra(k),
+                                                  passo_inicial, max_passos);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        int bloco = (num_amostras + num_threads - 1) / num_threads;
+        for (int t = 0; t < num_threads; t++) {
+            int inicio = t * bloco;
+            int fim = std::min(inicio + bloco, num_amostras);
+            if (inicio < fim) {
+                threads.emplace_back(construir_bloco, inicio, fim);
+            }
+        }
+        for (auto& th : threads) th.join();
+
+        construida_ = true;
+    }
+
+    // A tabela vale enquanto massa e posição do observador não mudam
+    bool valida(double rs, double r0, double b_max) const {
+        return construida_ && rs == rs_ && r0 == r0_ && b_max <= b_max_;
+    }
+
+    bool construida() const { return construida_; }
+    double b_max() const { return b_max_; }
+
+    // Trajetória pré-computada mais próxima de b
+    const TrajetoriaPlanar& trajetoria(double b) const {
+        int k = static_cast<int>(std::lround(indice_do_b(b)));
+        k = std::max(0, std::min(num_amostras_ - 1, k));
+        return trajetorias_[k];
+    }
+
+    // Ângulo de deflexão final interpolado entre amostras vizinhas.
+    // Só tem significado quando as duas vizinhas escapam.
+    double psi_final_interpolado(double b) const {
+        double x = indice_do_b(b);
+        int k0 = static_cast<int>(x);
+        k0 = std::max(0, std::min(num_amostras_ - 2, k0));
+        int k1 = k0 + 1;
+        const TrajetoriaPlanar& a = trajetorias_[k0];
+        const TrajetoriaPlanar& c = trajetorias_[k1];
+        if (a.capturado || c.capturado) {
+            return a.capturado ? c.psi_final : a.psi_final;
+        }
+        double frac = x - k0;
+        return a.psi_final * (1.0 - frac) + c.psi_final * frac;
+    }
+};
+
+} // namespace BuracoNegro
+
+#endif // TABELA_DEFLEXAO_HPP
@@ -0,0 +1,327 @@
+// ============================================================
+// SimuladorBuracoNegro - Bancada de Benchmark
+// Autor: Luiz Tiago Wilcke
+//
+// Matriz fixa de cenas com aquecimento e mediana de N repetições,
+// reportando ns/raio e avaliações de derivada/raio. Com uma linha
+// de base JSON gravada (make bench-baseline), regressões acima do
+// limiar fazem o alvo falhar — é o portão de todas as otimizações.
+// ============================================================
+
+#include "ray_tracer.hpp"
+#include <getopt.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace BuracoNegro;
+
+// ============================================================
+// MATRIZ DE CENAS
+// ============================================================
+
+struct Cena {
+    std::string nome;
+    double massa_solar;
+    double spin;
+    double inclinacao_graus;
+    int resolucao;          // Quadro quadrado resolucao × resolucao
+};
+
+// Massa {10, 1e6} × spin {0, 0.9} × inclinação {5°, 85°} × {256², 1024²}.
+// A massa só muda a escala absoluta (a câmera fica em rs), mas cobre
+// regressões de unidades; spin alterna Schwarzschild/Kerr; a inclinação
+// alterna quase face-on e quase edge-on (custos de disco bem distintos).
+static std::vector<Cena> montar_matriz(bool rapido) {
+    std::vector<Cena> cenas;
+    for (double massa : {10.0, 1.0e6}) {
+        for (double spin : {0.0, 0.9}) {
+            for (double inc : {5.0, 85.0}) {
+                for (int res : {256, 1024}) {
+                    if (rapido && res > 256) continue;
+                    std::ostringstream nome;
+                    nome << "m" << massa << "_a" << spin
+                         << "_i" << inc << "_r" << res;
+                    cenas.push_back({nome.str(), massa, spin, inc, res});
+                }
+            }
+        }
+    }
+    return cenas;
+}
+
+// ============================================================
+// MEDIÇÃO
+// ============================================================
+
+struct Medicao {
+    double ns_por_raio = 0.0;        // Mediana das repetições
+    double avaliacoes_por_raio = 0.0;  // Determinístico (igual em todas)
+};
+
+static Medicao medir_cena(const Cena& cena, int repeticoes, int aquecimento,
+                          int threads) {
+    RayTracer tracer(cena.massa_solar, 0.1, cena.spin);
+
+    Camera cam;
+    cam.largura = cena.resolucao;
+    cam.altura = cena.resolucao;
+    cam.r_observador = 100.0;
+    cam.theta_observador = (90.0 - cena.inclinacao_graus) * M_PI / 180.0;
+    cam.fov_horizontal = 45.0 * M_PI / 180.0;
+    cam.fov_vertical = 45.0 * M_PI / 180.0;
+    tracer.set_camera(cam);
+    tracer.set_threads(threads);
+
+    std::vector<double> amostras;
+    amostras.reserve(repeticoes);
+
+    Medicao medicao;
+    for (int rep = 0; rep < aquecimento + repeticoes; rep++) {
+        tracer.renderizar();
+        const EstatisticasRender& stats = tracer.estatisticas();
+        if (rep < aquecimento) continue;
+
+        amostras.push_back(stats.tempo_tracado * 1e9 / stats.pixels);
+        medicao.avaliacoes_por_raio =
+            static_cast<double>(stats.avaliacoes_derivadas) / stats.pixels;
+    }
+
+    std::sort(amostras.begin(), amostras.end());
+    medicao.ns_por_raio = amostras[amostras.size() / 2];
+    return medicao;
+}
+
+// ============================================================
+// VERIFICAÇÃO DO LIMITE a → 0
+// ============================================================
+
+// O traçado de Kerr usa o mesmo mapeamento pixel → (u_θ, u_φ) do
+// caminho de Schwarzschild, então um spin minúsculo tem que devolver
+// o mesmo mapa de desfechos pixel a pixel (só a separatriz do disco
+// pode oscilar). Renderiza cada inclinação com a = 0 e a = 0.02 e
+// compara os planos de destino — é o portão de correção do backend
+// de Kerr, no mesmo espírito do portão de regressão de desempenho.
+static bool verificar_limite_schwarzschild(int threads) {
+    const int res = 256;
+    const double tolerancia_pct = 0.1;  // Fração da separatriz
+    bool ok = true;
+
+    std::cout << "Verificação a → 0: Kerr(a=0.02) vs Schwarzschild, "
+              << res << "x" << res << "\n\n";
+    std::cout << std::left << std::setw(16) << "inclinação"
+              << std::right << std::setw(14) << "pixels_dif"
+              << std::setw(10) << "%" << "\n";
+
+    for (double inc : {5.0, 45.0, 85.0}) {
+        std::vector<uint8_t> destinos[2];
+        for (int passada = 0; passada < 2; passada++) {
+            double spin = passada == 0 ? 0.0 : 0.02;
+            RayTracer tracer(10.0, 0.1, spin);
+
+            Camera cam;
+            cam.largura = res;
+            cam.altura = res;
+            cam.r_observador = 100.0;
+            cam.theta_observador = (90.0 - inc) * M_PI / 180.0;
+            cam.fov_horizontal = 45.0 * M_PI / 180.0;
+            cam.fov_vertical = 45.0 * M_PI / 180.0;
+            tracer.set_camera(cam);
+            tracer.set_threads(threads);
+            tracer.set_captura_mapa(true);
+
+            tracer.renderizar();
+            destinos[passada] = tracer.mapa_raios().destino;
+        }
+
+        size_t n = destinos[0].size();
+        size_t dif = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (destinos[0][i] != destinos[1][i]) dif++;
+        }
+        double pct = 100.0 * dif / n;
+
+        std::ostringstream nome;
+        nome << "i" << inc;
+        std::cout << std::left << std::setw(16) << nome.str()
+                  << std::right << std::setw(14) << dif
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(9) << pct << "%";
+        if (pct > tolerancia_pct) {
+            std::cout << "  DIVERGIU";
+            ok = false;
+        }
+        std::cout << "\n" << std::flush;
+    }
+    return ok;
+}
+
+// ============================================================
+// LINHA DE BASE JSON
+// ============================================================
+
+// Formato: { "nome_da_cena": ns_por_raio, ... } — uma cena por linha,
+// gravado e lido à mão como o resto dos JSON do projeto
+static bool gravar_baseline(const std::string& caminho,
+                            const std::vector<std::string>& nomes,
+                            const std::vector<Medicao>& medicoes) {
+    std::ofstream arquivo(caminho);
+    if (!arquivo.is_open()) return false;
+
+    arquivo << "{\n";
+    for (size_t c = 0; c < nomes.size(); c++) {
+        arquivo << "  \"" << nomes[c] << "\": " << medicoes[c].ns_por_raio
+                << (c + 1 < nomes.size() ? "," : "") << "\n";
+    }
+    arquivo << "}\n";
+    return arquivo.good();
+}
+
+static bool carregar_baseline(const std::string& caminho,
+                              std::vector<std::pair<std::string, double>>& saida) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo.is_open()) return false;
+
+    std::string linha;
+    while (std::getline(arquivo, linha)) {
+        size_t abre = linha.find('"');
+        if (abre == std::string::npos) continue;
+        size_t fecha = linha.find('"', abre + 1);
+        size_t pontos = linha.find(':', fecha);
+        if (fecha == std::string::npos || pontos == std::string::npos) continue;
+        saida.emplace_back(linha.substr(abre + 1, fecha - abre - 1),
+                           std::stod(linha.substr(pontos + 1)));
+    }
+    return true;
+}
+
+// ============================================================
+// PROGRAMA
+// ============================================================
+
+int main(int argc, char* argv[]) {
+    int repeticoes = 0;     // 0 = padrão por resolução (5 / 3)
+    int aquecimento = 1;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    double limiar_pct = 10.0;
+    bool rapido = false;
+    bool gravar = false;
+    bool verificar = false;
+    std::string caminho_baseline = "bench_baseline.json";
+
+    static struct option opcoes_longas[] = {
+        {"repeticoes",       required_argument, nullptr, 'n'},
+        {"threads",          required_argument, nullptr, 't'},
+        {"limiar",           required_argument, nullptr, 'l'},
+        {"rapido",           no_argument,       nullptr, 'r'},
+        {"gravar-baseline",  no_argument,       nullptr, 'g'},
+        {"baseline",         required_argument, nullptr, 'b'},
+        {"verificar",        no_argument,       nullptr, 'v'},
+        {nullptr, 0, nullptr, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "n:t:l:rgb:v", opcoes_longas,
+                              nullptr)) != -1) {
+        switch (opt) {
+            case 'n': repeticoes = std::stoi(optarg); break;
+            case 't': threads = std::stoi(optarg); break;
+            case 'l': limiar_pct = std::stod(optarg); break;
+            case 'r': rapido = true; break;
+            case 'g': gravar = true; break;
+            case 'b': caminho_baseline = optarg; break;
+            case 'v': verificar = true; break;
+            default:
+                std::cerr << "Uso: " << argv[0]
+                          << " [-n reps] [-t threads] [-l limiar%]"
+                             " [--rapido] [--gravar-baseline]"
+                             " [--baseline arq.json] [--verificar]\n";
+                return 1;
+        }
+    }
+
+    if (verificar) {
+        if (!verificar_limite_schwarzschild(threads)) {
+            std::cerr << "\nLimite a → 0 DIVERGIU do caminho de "
+                         "Schwarzschild — verificação FALHOU\n";
+            return 1;
+        }
+        std::cout << "\nVerificação concluída: limite a → 0 bate com "
+                     "Schwarzschild.\n";
+        return 0;
+    }
+
+    std::vector<Cena> cenas = montar_matriz(rapido);
+
+    std::vector<std::pair<std::string, double>> baseline;
+    bool tem_baseline = !gravar &&
+                        carregar_baseline(caminho_baseline, baseline);
+
+    std::cout << "Benchmark: " << cenas.size() << " cenas, " << threads
+              << " threads, aquecimento " << aquecimento
+              << (tem_baseline
+                      ? ", baseline '" + caminho_baseline + "'"
+                      : ", sem baseline")
+              << "\n\n";
+    std::cout << std::left << std::setw(26) << "cena"
+              << std::right << std::setw(12) << "ns/raio"
+              << std::setw(12) << "aval/raio"
+              << std::setw(10) << "Δ%" << "\n";
+
+    std::vector<std::string> nomes;
+    std::vector<Medicao> medicoes;
+    int regressoes = 0;
+
+    for (const Cena& cena : cenas) {
+        int reps = repeticoes > 0 ? repeticoes
+                                  : (cena.resolucao <= 256 ? 5 : 3);
+        Medicao m = medir_cena(cena, reps, aquecimento, threads);
+        nomes.push_back(cena.nome);
+        medicoes.push_back(m);
+
+        std::cout << std::left << std::setw(26) << cena.nome
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << m.ns_por_raio
+                  << std::setw(12) << m.avaliacoes_por_raio;
+
+        if (tem_baseline) {
+            auto ref = std::find_if(baseline.begin(), baseline.end(),
+                [&](const auto& p) { return p.first == cena.nome; });
+            if (ref != baseline.end() && ref->second > 0.0) {
+                double delta = 100.0 * (m.ns_por_raio / ref->second - 1.0);
+                std::cout << std::showpos << std::setw(9) << delta
+                          << std::noshowpos << "%";
+                if (delta > limiar_pct) {
+                    std::cout << "  REGRESSÃO";
+                    regressoes++;
+                }
+            } else {
+                std::cout << std::setw(10) << "nova";
+            }
+        }
+        std::cout << "\n" << std::flush;
+    }
+
+    if (gravar) {
+        if (!gravar_baseline(caminho_baseline, nomes, medicoes)) {
+            std::cerr << "\nErro ao gravar '" << caminho_baseline << "'\n";
+            return 1;
+        }
+        std::cout << "\nBaseline gravada em '" << caminho_baseline << "'\n";
+        return 0;
+    }
+
+    if (regressoes > 0) {
+        std::cerr << "\n" << regressoes << " cena(s) acima do limiar de "
+                  << limiar_pct << "% — benchmark FALHOU\n";
+        return 1;
+    }
+
+    std::cout << "\nBenchmark concluído"
+              << (tem_baseline ? " dentro do limiar" : "") << ".\n";
+    return 0;
+}
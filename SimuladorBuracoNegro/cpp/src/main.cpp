@@ -28,6 +28,24 @@ void imprimir_ajuda(const char* nome_programa) {
     std::cout << "  -H, --altura <px>      Altura da imagem (padrão: 600)\n";
     std::cout << "  -f, --fov <graus>      Campo de visão (padrão: 45)\n";
     std::cout << "  -t, --threads <n>      Número de threads (padrão: 4)\n";
+    std::cout << "      --afinidade        Fixa cada thread num núcleo (nós NUMA)\n";
+    std::cout << "  -T, --tabela           Usa tabela de deflexão (rápido, só spin 0)\n";
+    std::cout << "  -R, --rk45             Integrador adaptativo RK45 (Dormand-Prince)\n";
+    std::cout << "  -L, --lote             Integra raios em lotes SIMD ordenados por custo\n";
+    std::cout << "      --ef               Carta de Eddington-Finkelstein (regular no horizonte)\n";
+    std::cout << "      --f32              Campo distante em float32 no modo lote\n";
+    std::cout << "  -P, --progressivo      Renderização progressiva (prévia + refino)\n";
+    std::cout << "  -A, --aa               Anti-aliasing adaptativo nas bordas\n";
+    std::cout << "  -S, --streaming        Render em bandas com checkpoint (quadros 16K)\n";
+    std::cout << "  -q, --quadros <n>      Anima n quadros num único processo\n";
+    std::cout << "      --inc-final <θ>    Inclinação do último quadro (graus)\n";
+    std::cout << "      --dist-final <r>   Distância do último quadro (rs)\n";
+    std::cout << "      --fundo <ppm>      Mapa de céu equiretangular (PPM P6)\n";
+    std::cout << "      --formato <fmt>    Formato da imagem: png (padrão) ou ppm\n";
+    std::cout << "      --bin              Exporta planos binários (rgb + metadados)\n";
+    std::cout << "      --geodesicas <n>   Enxame de n partículas (modo trajetórias)\n";
+    std::cout << "      --espectral        Cor do disco pelo espectro de Planck deslocado\n";
+    std::cout << "      --cache            Reusa geodésicas entre varreduras do disco\n";
     std::cout << "  -o, --saida <dir>      Diretório de saída (padrão: ../saida)\n";
     std::cout << "  -a, --analise          Apenas imprimir análise física\n";
     std::cout << "  -h, --ajuda            Mostrar esta mensagem\n";
@@ -93,7 +111,7 @@ void menu_interativo(ConfiguracaoSimulacao& config) {
 // FUNÇÃO PRINCIPAL
 // ============================================================
 
-int main(int argc, char* argv[]) {
+int executar(int argc, char* argv[]) {
     ConfiguracaoSimulacao config;
     bool apenas_analise = false;
     bool modo_interativo = false;
@@ -108,6 +126,24 @@ int main(int argc, char* argv[]) {
         {"altura",      required_argument, nullptr, 'H'},
         {"fov",         required_argument, nullptr, 'f'},
         {"threads",     required_argument, nullptr, 't'},
+        {"tabela",      no_argument,       nullptr, 'T'},
+        {"rk45",        no_argument,       nullptr, 'R'},
+        {"lote",        no_argument,       nullptr, 'L'},
+        {"progressivo", no_argument,       nullptr, 'P'},
+        {"aa",          no_argument,       nullptr, 'A'},
+        {"streaming",   no_argument,       nullptr, 'S'},
+        {"quadros",     required_argument, nullptr, 'q'},
+        {"inc-final",   required_argument, nullptr, 1},
+        {"dist-final",  required_argument, nullptr, 2},
+        {"fundo",       required_argument, nullptr, 3},
+        {"formato",     required_argument, nullptr, 4},
+        {"bin",         no_argument,       nullptr, 5},
+        {"geodesicas",  required_argument, nullptr, 6},
+        {"afinidade",   no_argument,       nullptr, 7},
+        {"espectral",   no_argument,       nullptr, 8},
+        {"ef",          no_argument,       nullptr, 9},
+        {"f32",         no_argument,       nullptr, 10},
+        {"cache",       no_argument,       nullptr, 11},
         {"saida",       required_argument, nullptr, 'o'},
         {"analise",     no_argument,       nullptr, 'a'},
         {"interativo",  no_argument,       nullptr, 'I'},
@@ -116,7 +152,7 @@ int main(int argc, char* argv[]) {
     };
     
     int opt;
-    while ((opt = getopt_long(argc, argv, "m:s:i:d:W:H:f:t:o:aIh", opcoes_longas, nullptr)) != -1) {
+    while ((opt = getopt_long(argc, argv, "m:s:i:d:W:H:f:t:TRLPASq:o:aIh", opcoes_longas, nullptr)) != -1) {
         switch (opt) {
             case 'm':
                 config.massa_solar = std::stod(optarg);
@@ -145,6 +181,61 @@ int main(int argc, char* argv[]) {
             case 't':
                 config.num_threads = std::stoi(optarg);
                 break;
+            case 'T':
+                config.usar_tabela_deflexao = true;
+                break;
+            case 'R':
+                config.usar_rk45 = true;
+                break;
+            case 'L':
+                config.usar_lote = true;
+                break;
+            case 'P':
+                config.progressivo = true;
+                break;
+            case 'A':
+                config.antialiasing = true;
+                break;
+            case 'S':
+                config.streaming = true;
+                break;
+            case 'q':
+                config.quadros_animacao = std::stoi(optarg);
+                break;
+            case 1:
+                config.inclinacao_final = std::stod(optarg);
+                break;
+            case 2:
+                config.distancia_final = std::stod(optarg);
+                break;
+            case 3:
+                config.arquivo_fundo = optarg;
+                break;
+            case 4:
+                config.formato_imagem = optarg;
+                break;
+            case 5:
+                config.exportar_bin = true;
+                break;
+            case 6:
+                config.modo = ModoSimulacao::GEODESICAS;
+                config.num_particulas = std::stoi(optarg);
+                break;
+            case 7:
+                config.fixar_threads = true;
+                break;
+            case 8:
+                config.espectral = true;
+                break;
+            case 9:
+                config.usar_ef = true;
+                break;
+            case 10:
+                config.precisao_mista = true;
+                break;
+            case 11:
+                config.cache_geodesicas = true;
+                break;
             case 'o':
                 config.diretorio_saida = optarg;
                 break;
@@ -180,7 +271,46 @@ int main(int argc, char* argv[]) {
         simulador.analise_fisica();
         return 0;
     }
+
+#ifdef COM_MPI
+    // Com mais de um rank, o quadro único é repartido em tiles entre
+    // os ranks (rank 0 coordena e funde); os outros modos continuam
+    // por processo
+    int ranks_mpi = 1;
+    MPI_Comm_size(MPI_COMM_WORLD, &ranks_mpi);
+    if (ranks_mpi > 1) {
+        if (config.modo == ModoSimulacao::GEODESICAS ||
+            config.quadros_animacao > 1) {
+            int rank_mpi = 0;
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank_mpi);
+            if (rank_mpi == 0) {
+                std::cerr << "O modo distribuído cobre apenas a "
+                             "renderização de quadro único.\n";
+            }
+            return 1;
+        }
+        return simulador.renderizar_distribuido() ? 0 : 1;
+    }
+#endif
     
+    // Modo de trajetórias: enxame de partículas em lote
+    if (config.modo == ModoSimulacao::GEODESICAS) {
+        if (!simulador.simular_geodesicas()) {
+            std::cerr << "Erro na simulação de geodésicas!" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Animação em lote: todos os quadros num único processo
+    if (config.quadros_animacao > 1) {
+        if (!simulador.renderizar_animacao()) {
+            std::cerr << "Erro na animação!" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     // Renderização
     if (!simulador.renderizar()) {
         std::cerr << "Erro na renderização!" << std::endl;
@@ -199,3 +329,14 @@ int main(int argc, char* argv[]) {
     
     return 0;
 }
+
+int main(int argc, char* argv[]) {
+#ifdef COM_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    int codigo = executar(argc, argv);
+#ifdef COM_MPI
+    MPI_Finalize();
+#endif
+    return codigo;
+}
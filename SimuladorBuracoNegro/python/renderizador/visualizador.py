@@ -198,6 +198,48 @@ class VisualizadorBuracoNegro:
         plt.close(fig)
         print(f"Visualização salva em: {caminho}")
 
+# ============================================================
+# LEITURA DA EXPORTAÇÃO BINÁRIA DO SIMULADOR C++
+# ============================================================
+
+def carregar_bin(caminho):
+    """Carrega a exportação colunar do simulador (--bin) via memmap.
+
+    Devolve um dicionário com os planos 'r', 'g', 'b' (float32) e,
+    quando presentes, 'destino' (uint8: 0=horizonte, 1=disco,
+    2=infinito, 3=erro), 'r_impacto' (float32) e 'passos' (int32),
+    todos com forma (altura, largura), sem copiar o arquivo.
+    """
+    with open(caminho, 'rb') as f:
+        magica = f.read(8)
+        if magica != b'BNCOL001':
+            raise ValueError(f"arquivo não é uma exportação BNCOL001: {caminho}")
+        largura, altura, flags, _ = np.fromfile(f, dtype='<u4', count=4)
+        deslocamento = f.tell()
+
+    n = int(largura) * int(altura)
+    forma = (int(altura), int(largura))
+    planos = {}
+
+    def plano(nome, dtype, tamanho):
+        nonlocal deslocamento
+        planos[nome] = np.memmap(caminho, dtype=dtype, mode='r',
+                                 offset=deslocamento, shape=forma)
+        deslocamento += n * tamanho
+
+    if flags & 0x1:
+        plano('r', '<f4', 4)
+        plano('g', '<f4', 4)
+        plano('b', '<f4', 4)
+    if flags & 0x2:
+        plano('destino', 'u1', 1)
+    if flags & 0x4:
+        plano('r_impacto', '<f4', 4)
+    if flags & 0x8:
+        plano('passos', '<i4', 4)
+
+    return planos
+
 # ============================================================
 # VISUALIZADOR DE POTENCIAL EFETIVO
 # ============================================================